@@ -0,0 +1,51 @@
+# Native (non-Emscripten) build: configure with a desktop OCCT, e.g.
+#   cmake -S . -B build-native -DOpenCASCADE_DIR=<occt>/lib/cmake/opencascade
+find_package(OpenCASCADE REQUIRED)
+
+option(ENABLE_SANITIZERS "Build the native targets with address and undefined behavior sanitizers" OFF)
+
+set(CORE_NAME ${PROJECT_NAME}-core)
+set(CORE_OCCT_LIBS
+    TKXDESTEP TKSTEP TKSTEPAttr TKSTEP209 TKSTEPBase TKXSBase
+    TKBinXCAF TKXCAF TKVCAF TKBin TKBinL TKCAF TKLCAF TKCDF
+    TKV3d TKService TKMesh TKHLR TKTopAlgo TKGeomAlgo TKBRep TKGeomBase TKG3d TKG2d TKMath TKernel
+)
+
+add_library(${CORE_NAME} STATIC ${CORE_SOURCES})
+target_include_directories(${CORE_NAME} PUBLIC ${CMAKE_SOURCE_DIR}/src ${OpenCASCADE_INCLUDE_DIR})
+target_link_libraries(${CORE_NAME} PUBLIC ${CORE_OCCT_LIBS})
+
+if (ENABLE_SANITIZERS)
+    target_compile_options(${CORE_NAME} PUBLIC -fsanitize=address,undefined -fno-omit-frame-pointer)
+    target_link_options(${CORE_NAME} PUBLIC -fsanitize=address,undefined)
+endif()
+
+# Runs the import pipeline on files given on the command line
+add_executable(${PROJECT_NAME}-headless src/HeadlessMain.cpp)
+target_link_libraries(${PROJECT_NAME}-headless PRIVATE ${CORE_NAME})
+
+# Import pipeline benchmark, see benchmark/compare_baseline.py for regression checks
+add_executable(${PROJECT_NAME}-benchmark benchmark/ImportBenchmark.cpp)
+target_link_libraries(${PROJECT_NAME}-benchmark PRIVATE ${CORE_NAME})
+if (ENABLE_SANITIZERS)
+    # The sanitizer runtime owns malloc, count operator new only
+    target_compile_definitions(${PROJECT_NAME}-benchmark PRIVATE BENCHMARK_NO_MALLOC_HOOKS)
+endif()
+
+# Pointer input routing benchmark on a synthetic event replay, ImGui core without a rendering backend
+set(IMGUI_SOURCE_DIR ${CMAKE_SOURCE_DIR}/dependencies/ImGui/imgui-1.88)
+add_library(imgui-core STATIC
+    ${IMGUI_SOURCE_DIR}/imgui.cpp
+    ${IMGUI_SOURCE_DIR}/imgui_draw.cpp
+    ${IMGUI_SOURCE_DIR}/imgui_tables.cpp
+    ${IMGUI_SOURCE_DIR}/imgui_widgets.cpp
+)
+target_include_directories(imgui-core PUBLIC ${IMGUI_SOURCE_DIR})
+
+add_executable(${PROJECT_NAME}-input-benchmark benchmark/InputBenchmark.cpp src/InputRouter.cpp src/InputRouter.hpp)
+target_link_libraries(${PROJECT_NAME}-input-benchmark PRIVATE ${CORE_NAME} imgui-core)
+
+# Synthetic STEP/BRep models of controlled size, see benchmark/scaling_sweep.py
+add_executable(${PROJECT_NAME}-generator benchmark/GenerateModel.cpp)
+target_include_directories(${PROJECT_NAME}-generator PRIVATE ${OpenCASCADE_INCLUDE_DIR})
+target_link_libraries(${PROJECT_NAME}-generator PRIVATE TKXDESTEP TKXCAF TKPrim ${CORE_OCCT_LIBS})
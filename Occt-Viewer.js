@@ -23,6 +23,25 @@ var OcctViewerModule =
 
 const OcctViewerModuleInitialized = createOcctViewerModule(OcctViewerModule);
 OcctViewerModuleInitialized.then(function(Module) {
+    // Save a JSON string as a file; the URL is revoked once the download has started
+    function downloadJson(theJson, theFileName) {
+        var aBlob = new Blob([theJson], { type: 'application/json' });
+        var aLink = document.createElement('a');
+        aLink.href = URL.createObjectURL(aBlob);
+        aLink.download = theFileName;
+        aLink.click();
+        setTimeout(function() { URL.revokeObjectURL(aLink.href); }, 1000);
+    }
+
+    // Save the recorded trace events as a file for chrome://tracing or ui.perfetto.dev
+    Module.downloadTrace = function(theFileName) {
+        downloadJson(Module.traceDump(), theFileName || 'occt-viewer-trace.json');
+    };
+
+    // Save the per-geometry memory report as JSON
+    Module.downloadMemoryReport = function(theFileName) {
+        downloadJson(Module.memoryReport(), theFileName || 'occt-viewer-memory.json');
+    };
     //OcctViewerModule.setCubemapBackground ("cubemap.jpg");
     //OcctViewerModule.openFromUrl ("ball", "samples/Ball.brep");
 });
\ No newline at end of file
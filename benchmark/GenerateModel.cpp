@@ -0,0 +1,254 @@
+// Synthetic CAD workload generator for scaling tests.
+// Builds an XCAF document with named, colored parts and assembly references and writes it as STEP or BRep.
+//
+// Usage: Occt-Wasm-ImGui-generator <layout> [options] <output.step|output.brep>
+//   flat       --count N              N distinct solids under one product
+//   deep       --depth D [--count N]  D nested assemblies, each holding N solids and the next level
+//   instances  --count M              M placed instances of a single part
+//   faces      --faces K [--count N]  N prism solids with K faces each
+//   fasteners  --count N              one plate carrying N small instances of a fastener, for size culling
+
+#include <BRepBuilderAPI_MakeFace.hxx>
+#include <BRepBuilderAPI_MakePolygon.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCone.hxx>
+#include <BRepPrimAPI_MakePrism.hxx>
+#include <BRepTools.hxx>
+#include <Quantity_Color.hxx>
+#include <STEPCAFControl_Writer.hxx>
+#include <TDataStd_Name.hxx>
+#include <TDocStd_Document.hxx>
+#include <TopoDS_Shape.hxx>
+#include <XCAFApp_Application.hxx>
+#include <XCAFDoc_ColorTool.hxx>
+#include <XCAFDoc_DocumentTool.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+#include <gp.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+
+namespace
+{
+    struct Options
+    {
+        std::string Layout;
+        std::string Output;
+        int Count { 1 };
+        int Depth { 1 };
+        int Faces { 6 };
+    };
+
+    constexpr double s_PartSize = 10.0;
+    constexpr double s_Spacing = 15.0;
+
+    // Distinct, deterministic colors: walk the hue circle by the golden angle
+    Quantity_Color PartColor(int index)
+    {
+        const double hue = std::fmod(index * 137.508, 360.0);
+        return Quantity_Color(hue, 0.6, 0.7, Quantity_TOC_HLS);
+    }
+
+    // Lays instances out on a square grid in the XY plane
+    TopLoc_Location GridLocation(int index, int count, double z = 0.0)
+    {
+        const int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count)))));
+        gp_Trsf trsf;
+        trsf.SetTranslation(gp_Vec((index % columns) * s_Spacing, (index / columns) * s_Spacing, z));
+        return TopLoc_Location(trsf);
+    }
+
+    // Alternates the primitives the viewer already uses for its samples
+    TopoDS_Shape MakePrimitive(int index)
+    {
+        if (index % 2 == 0) {
+            return BRepPrimAPI_MakeBox(s_PartSize, s_PartSize, s_PartSize).Shape();
+        }
+        return BRepPrimAPI_MakeCone(gp_Ax2(gp_Pnt(s_PartSize * 0.5, s_PartSize * 0.5, 0.0), gp::DZ()),
+                                    s_PartSize * 0.5, 0.0, s_PartSize).Shape();
+    }
+
+    // Prism over a regular polygon: (faces - 2) sides plus top and bottom
+    TopoDS_Shape MakePrismWithFaces(int faces)
+    {
+        const int sides = std::max(3, faces - 2);
+        const double radius = s_PartSize * 0.5;
+        BRepBuilderAPI_MakePolygon polygon;
+        for (int i = 0; i < sides; ++i) {
+            const double angle = 2.0 * M_PI * i / sides;
+            polygon.Add(gp_Pnt(radius + radius * std::cos(angle), radius + radius * std::sin(angle), 0.0));
+        }
+        polygon.Close();
+        const TopoDS_Face base = BRepBuilderAPI_MakeFace(polygon.Wire(), Standard_True).Face();
+        return BRepPrimAPI_MakePrism(base, gp_Vec(0.0, 0.0, s_PartSize)).Shape();
+    }
+
+    class ModelBuilder
+    {
+    public:
+        ModelBuilder()
+        {
+            XCAFApp_Application::GetApplication()->NewDocument("MDTV-XCAF", m_Doc);
+            m_ShapeTool = XCAFDoc_DocumentTool::ShapeTool(m_Doc->Main());
+            m_ColorTool = XCAFDoc_DocumentTool::ColorTool(m_Doc->Main());
+        }
+
+        TDF_Label AddPart(const TopoDS_Shape& shape, const std::string& name, const Quantity_Color& color)
+        {
+            TDF_Label label = m_ShapeTool->AddShape(shape, Standard_False);
+            TDataStd_Name::Set(label, name.c_str());
+            m_ColorTool->SetColor(label, color, XCAFDoc_ColorSurf);
+            return label;
+        }
+
+        TDF_Label AddAssembly(const std::string& name)
+        {
+            TDF_Label label = m_ShapeTool->NewShape();
+            TDataStd_Name::Set(label, name.c_str());
+            return label;
+        }
+
+        void AddComponent(const TDF_Label& assembly, const TDF_Label& shape, const TopLoc_Location& location, const std::string& name)
+        {
+            TDF_Label component = m_ShapeTool->AddComponent(assembly, shape, location);
+            TDataStd_Name::Set(component, name.c_str());
+        }
+
+        bool Write(const std::string& path)
+        {
+            m_ShapeTool->UpdateAssemblies();
+
+            const bool isBRep = path.size() > 5 && (path.compare(path.size() - 5, 5, ".brep") == 0 || path.compare(path.size() - 5, 5, ".BREP") == 0);
+            if (isBRep) {
+                // Plain BRep keeps geometry and placements only, names and colors need STEP
+                TDF_LabelSequence roots;
+                m_ShapeTool->GetFreeShapes(roots);
+                if (roots.IsEmpty()) return false;
+                return BRepTools::Write(m_ShapeTool->GetShape(roots.First()), path.c_str());
+            }
+
+            STEPCAFControl_Writer writer;
+            writer.SetColorMode(Standard_True);
+            writer.SetNameMode(Standard_True);
+            if (!writer.Transfer(m_Doc, STEPControl_AsIs)) return false;
+            return writer.Write(path.c_str()) == IFSelect_RetDone;
+        }
+
+    private:
+        Handle(TDocStd_Document) m_Doc;
+        Handle(XCAFDoc_ShapeTool) m_ShapeTool;
+        Handle(XCAFDoc_ColorTool) m_ColorTool;
+    };
+
+    void BuildFlat(ModelBuilder& builder, int count)
+    {
+        TDF_Label product = builder.AddAssembly("Product");
+        for (int i = 0; i < count; ++i) {
+            const std::string name = "Part_" + std::to_string(i);
+            TDF_Label part = builder.AddPart(MakePrimitive(i), name, PartColor(i));
+            builder.AddComponent(product, part, GridLocation(i, count), name + "_1");
+        }
+    }
+
+    void BuildDeep(ModelBuilder& builder, int depth, int count)
+    {
+        // Create the innermost level first so each assembly can reference the one below it
+        TDF_Label child;
+        for (int level = depth - 1; level >= 0; --level) {
+            TDF_Label assembly = builder.AddAssembly(level == 0 ? "Product" : "Assembly_" + std::to_string(level));
+            for (int i = 0; i < count; ++i) {
+                const int index = level * count + i;
+                const std::string name = "Part_" + std::to_string(level) + "_" + std::to_string(i);
+                TDF_Label part = builder.AddPart(MakePrimitive(index), name, PartColor(index));
+                builder.AddComponent(assembly, part, GridLocation(i, count), name + "_1");
+            }
+            if (!child.IsNull()) {
+                builder.AddComponent(assembly, child, GridLocation(0, 1, s_Spacing), "Assembly_" + std::to_string(level + 1) + "_1");
+            }
+            child = assembly;
+        }
+    }
+
+    void BuildInstances(ModelBuilder& builder, int count)
+    {
+        TDF_Label product = builder.AddAssembly("Product");
+        TDF_Label part = builder.AddPart(MakePrimitive(0), "Part", PartColor(0));
+        for (int i = 0; i < count; ++i) {
+            builder.AddComponent(product, part, GridLocation(i, count), "Part_" + std::to_string(i + 1));
+        }
+    }
+
+    void BuildFaces(ModelBuilder& builder, int faces, int count)
+    {
+        TDF_Label product = builder.AddAssembly("Product");
+        for (int i = 0; i < count; ++i) {
+            // A new shape per part, otherwise they would all be instances of the same one
+            const std::string name = "Prism_" + std::to_string(i);
+            TDF_Label part = builder.AddPart(MakePrismWithFaces(faces), name, PartColor(i));
+            builder.AddComponent(product, part, GridLocation(i, count), name + "_1");
+        }
+    }
+
+    void BuildFasteners(ModelBuilder& builder, int count)
+    {
+        TDF_Label product = builder.AddAssembly("Product");
+        const int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count)))));
+        const double plateSize = columns * s_Spacing;
+        TDF_Label plate = builder.AddPart(BRepPrimAPI_MakeBox(plateSize, plateSize, s_PartSize * 0.2).Shape(), "Plate", PartColor(0));
+        builder.AddComponent(product, plate, TopLoc_Location(), "Plate_1");
+
+        // A fastener is a tenth of a grid cell, a few pixels once the whole plate is in view
+        const double fastenerSize = s_PartSize * 0.1;
+        TDF_Label fastener = builder.AddPart(BRepPrimAPI_MakeBox(fastenerSize, fastenerSize, fastenerSize).Shape(), "Fastener", PartColor(1));
+        for (int i = 0; i < count; ++i) {
+            builder.AddComponent(product, fastener, GridLocation(i, count, s_PartSize * 0.2), "Fastener_" + std::to_string(i + 1));
+        }
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options)
+    {
+        if (argc < 3) return false;
+        options.Layout = argv[1];
+        for (int i = 2; i < argc; ++i) {
+            const std::string arg(argv[i]);
+            if (arg == "--count" && i + 1 < argc) options.Count = std::atoi(argv[++i]);
+            else if (arg == "--depth" && i + 1 < argc) options.Depth = std::atoi(argv[++i]);
+            else if (arg == "--faces" && i + 1 < argc) options.Faces = std::atoi(argv[++i]);
+            else options.Output = arg;
+        }
+        return !options.Output.empty() && options.Count > 0 && options.Depth > 0 && options.Faces >= 5;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " flat|deep|instances|faces|fasteners [--count N] [--depth D] [--faces K>=5] <output.step|output.brep>" << std::endl;
+        return 1;
+    }
+
+    ModelBuilder builder;
+    if (options.Layout == "flat") BuildFlat(builder, options.Count);
+    else if (options.Layout == "deep") BuildDeep(builder, options.Depth, options.Count);
+    else if (options.Layout == "instances") BuildInstances(builder, options.Count);
+    else if (options.Layout == "faces") BuildFaces(builder, options.Faces, options.Count);
+    else if (options.Layout == "fasteners") BuildFasteners(builder, options.Count);
+    else {
+        std::cerr << "Unknown layout " << options.Layout << std::endl;
+        return 1;
+    }
+
+    if (!builder.Write(options.Output)) {
+        std::cerr << "Unable to write " << options.Output << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,424 @@
+// Import pipeline benchmark.
+// Runs every phase of the import (read, tree, mesh, display bookkeeping, index map, bvh) on a corpus of STEP/BRep files
+// and prints wall time, CPU time, peak resident set, resident set growth, allocations and Geometry moves per phase as JSON.
+// There is no viewer: display calls go to a RecordingDisplaySink, so "display_bookkeeping" only covers
+// GeometryManager's side of displaying (memory governor, visibility), not presentations.
+//
+// Usage: Occt-Wasm-ImGui-benchmark [--runs N] [--output result.json] [--trace trace.json] [--verbose] <file|directory> [...]
+
+#include "GeometryManager.hpp"
+#include "Geometry.hpp"
+#include "DisplaySink.hpp"
+#include "Trace.hpp"
+
+#include <Message.hxx>
+#include <Message_Messenger.hxx>
+#include <Message_PrinterOStream.hxx>
+#include <Standard_Version.hxx>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__) && !defined(BENCHMARK_NO_MALLOC_HOOKS)
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* ptr, size_t size);
+extern "C" void* __libc_memalign(size_t alignment, size_t size);
+#define BENCHMARK_MALLOC_HOOKS 1
+#endif
+
+
+namespace
+{
+    // Counts go through malloc when possible: OCCT allocates through Standard::Allocate, which bypasses operator new
+    std::atomic<size_t> s_AllocCount { 0 };
+    std::atomic<size_t> s_AllocBytes { 0 };
+
+    inline void CountAllocation(size_t size)
+    {
+        s_AllocCount.fetch_add(1, std::memory_order_relaxed);
+        s_AllocBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    // /proc is read with plain system calls into a stack buffer, stdio would allocate inside the counted phases
+    bool ReadProcFile(const char* path, char* buffer, size_t size)
+    {
+        const int fd = open(path, O_RDONLY);
+        if (fd < 0) return false;
+        const ssize_t length = read(fd, buffer, size - 1);
+        close(fd);
+        if (length <= 0) return false;
+        buffer[length] = '\0';
+        return true;
+    }
+
+    // Current resident set, unlike ru_maxrss which is the high-water mark of the whole process
+    long ReadRssKB()
+    {
+        char buffer[128];
+        if (!ReadProcFile("/proc/self/statm", buffer, sizeof(buffer))) return 0;
+
+        char* residentPages = nullptr;
+        std::strtol(buffer, &residentPages, 10);  // Skips the total size
+        return std::strtol(residentPages, nullptr, 10) * (sysconf(_SC_PAGESIZE) / 1024);
+    }
+
+    // Resets the resident set high-water mark (VmHWM) to the current resident set, Linux 4.0 and later
+    void ResetPeakRss()
+    {
+        const int fd = open("/proc/self/clear_refs", O_WRONLY);
+        if (fd < 0) return;
+        static bool s_Warned = false;
+        if (write(fd, "5", 1) != 1 && !s_Warned) {
+            std::cerr << "Cannot reset VmHWM, peak_rss_kb is the process peak" << std::endl;
+            s_Warned = true;
+        }
+        close(fd);
+    }
+
+    // Resident set high-water mark since the last ResetPeakRss()
+    long ReadPeakRssKB()
+    {
+        char buffer[4096];
+        if (!ReadProcFile("/proc/self/status", buffer, sizeof(buffer))) return 0;
+
+        const char* line = std::strstr(buffer, "VmHWM:");
+        return line ? std::strtol(line + 6, nullptr, 10) : 0;  // Kilobytes
+    }
+
+    struct Sample
+    {
+        double WallMs;
+        double CpuMs;
+        long RssKB;
+        size_t AllocCount;
+        size_t AllocBytes;
+        size_t GeometryMoves;
+    };
+
+    Sample TakeSample()
+    {
+        rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+
+        Sample sample;
+        sample.WallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        sample.CpuMs = (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0
+                     + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+        sample.RssKB = ReadRssKB();
+        sample.AllocCount = s_AllocCount.load(std::memory_order_relaxed);
+        sample.AllocBytes = s_AllocBytes.load(std::memory_order_relaxed);
+        sample.GeometryMoves = Geometry::GetMoveCount();
+        return sample;
+    }
+
+    struct PhaseResult
+    {
+        std::string Name;
+        bool Succeeded { true };
+        std::vector<double> WallMs;  // One entry per run
+        std::vector<double> CpuMs;
+        long PeakRssKB { 0 };            // Highest resident set during the phase, over all runs
+        std::vector<double> RssDeltaKB;  // Resident set growth over the phase, negative if it released memory
+        size_t AllocCount { 0 };     // From the first run
+        size_t AllocBytes { 0 };
+        size_t GeometryMoves { 0 };  // Geometry is move-only, this is its whole copy traffic
+    };
+
+    struct FileResult
+    {
+        std::string File;
+        std::string Format;
+        size_t Bytes { 0 };
+        size_t GeometryCount { 0 };
+        size_t InstanceCount { 0 };
+        std::vector<PhaseResult> Phases;
+    };
+
+    double Median(std::vector<double> values)
+    {
+        if (values.empty()) return 0.0;
+        std::sort(values.begin(), values.end());
+        const size_t mid = values.size() / 2;
+        return values.size() % 2 ? values[mid] : 0.5 * (values[mid - 1] + values[mid]);
+    }
+
+    std::string JsonEscape(const std::string& str)
+    {
+        std::string escaped;
+        escaped.reserve(str.size());
+        for (char c : str) {
+            switch (c) {
+            case '"':  escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    escaped += buffer;
+                }
+                else {
+                    escaped += c;
+                }
+            }
+        }
+        return escaped;
+    }
+
+    bool IsStepFile(const std::string& ext) { return ext == ".step" || ext == ".stp" || ext == ".STEP" || ext == ".STP"; }
+    bool IsBRepFile(const std::string& ext) { return ext == ".brep" || ext == ".BREP"; }
+
+    void CollectFiles(const std::filesystem::path& path, std::vector<std::filesystem::path>& files)
+    {
+        if (!std::filesystem::is_directory(path)) {
+            files.push_back(path);
+            return;
+        }
+        std::vector<std::filesystem::path> found;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(path)) {
+            const std::string ext = entry.path().extension().string();
+            if (entry.is_regular_file() && (IsStepFile(ext) || IsBRepFile(ext))) {
+                found.push_back(entry.path());
+            }
+        }
+        std::sort(found.begin(), found.end());  // Stable order so results line up with the baseline
+        files.insert(files.end(), found.begin(), found.end());
+    }
+
+    FileResult RunFile(const std::filesystem::path& path, int runs)
+    {
+        FileResult result;
+        result.File = path.string();
+        const bool isBRep = IsBRepFile(path.extension().string());
+        result.Format = isBRep ? "brep" : "step";
+
+        // Keep disk I/O out of the read phase
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        const std::string content = buffer.str();
+        result.Bytes = content.size();
+
+        for (int run = 0; run < runs; ++run) {
+            // A fresh manager per run, which closes its XCAF document when destroyed
+            RecordingDisplaySink sink;
+            std::unique_ptr<GeometryManager> pManager(new GeometryManager(&sink));
+            std::istringstream stream(content);
+            const std::string fileName = path.filename().string();
+
+            const std::vector<std::pair<const char*, std::function<bool()>>> phases = {
+                { "read", [&]() {
+                    return isBRep ? pManager->GetOCCDocFromBRepFile(fileName.c_str(), stream)
+                                  : pManager->GetOCCDocFromStepFile(fileName.c_str(), stream);
+                } },
+                { "tree", [&]() { return pManager->LoadGeometryFromOCCDoc(); } },
+                { "mesh", [&]() { pManager->MeshAllGeometry(); return true; } },
+                { "display_bookkeeping", [&]() { pManager->DisplayAllGeometry(); return true; } },  // No presentations, see above
+                { "index_map", [&]() { pManager->CreateAllGeometryIndexMap(); return true; } },
+                { "bvh", [&]() { pManager->BuildBoundingVolumeHierarchy(); return true; } },
+            };
+
+            if (run == 0) {
+                for (const auto& phase : phases) {
+                    result.Phases.push_back(PhaseResult());
+                    result.Phases.back().Name = phase.first;
+                }
+            }
+
+            for (size_t i = 0; i < phases.size(); ++i) {
+                PhaseResult& phaseResult = result.Phases[i];
+                ResetPeakRss();
+                const Sample begin = TakeSample();
+                const bool succeeded = phases[i].second();
+                const Sample end = TakeSample();
+
+                phaseResult.Succeeded = phaseResult.Succeeded && succeeded;
+                phaseResult.WallMs.push_back(end.WallMs - begin.WallMs);
+                phaseResult.CpuMs.push_back(end.CpuMs - begin.CpuMs);
+                phaseResult.PeakRssKB = std::max(phaseResult.PeakRssKB, ReadPeakRssKB());
+                phaseResult.RssDeltaKB.push_back(static_cast<double>(end.RssKB - begin.RssKB));
+                if (run == 0) {
+                    phaseResult.AllocCount = end.AllocCount - begin.AllocCount;
+                    phaseResult.AllocBytes = end.AllocBytes - begin.AllocBytes;
+                    phaseResult.GeometryMoves = end.GeometryMoves - begin.GeometryMoves;
+                }
+                if (!succeeded) break;  // Later phases have nothing to work on
+            }
+
+            if (run == 0) {
+                result.GeometryCount = pManager->GetGeometryCount();
+                result.InstanceCount = pManager->GetInstanceGeometryIDs().size();
+            }
+        }
+        return result;
+    }
+
+    void WriteJson(std::ostream& os, const std::vector<FileResult>& results, int runs)
+    {
+        os << "{\n";
+        os << "  \"schema\": 1,\n";
+        os << "  \"occt_version\": \"" << OCC_VERSION_COMPLETE << "\",\n";
+        os << "  \"runs\": " << runs << ",\n";
+        os << "  \"files\": [";
+        for (size_t f = 0; f < results.size(); ++f) {
+            const FileResult& result = results[f];
+            os << (f ? ",\n" : "\n");
+            os << "    {\n";
+            os << "      \"file\": \"" << JsonEscape(result.File) << "\",\n";
+            os << "      \"format\": \"" << result.Format << "\",\n";
+            os << "      \"bytes\": " << result.Bytes << ",\n";
+            os << "      \"geometries\": " << result.GeometryCount << ",\n";
+            os << "      \"instances\": " << result.InstanceCount << ",\n";
+            os << "      \"phases\": [";
+            for (size_t p = 0; p < result.Phases.size(); ++p) {
+                const PhaseResult& phase = result.Phases[p];
+                os << (p ? ",\n" : "\n");
+                os << "        { \"name\": \"" << phase.Name << "\""
+                   << ", \"ok\": " << (phase.Succeeded ? "true" : "false")
+                   << ", \"wall_ms\": " << Median(phase.WallMs)
+                   << ", \"cpu_ms\": " << Median(phase.CpuMs)
+                   << ", \"peak_rss_kb\": " << phase.PeakRssKB
+                   << ", \"rss_delta_kb\": " << Median(phase.RssDeltaKB)
+                   << ", \"allocations\": " << phase.AllocCount
+                   << ", \"allocated_bytes\": " << phase.AllocBytes
+                   << ", \"geometry_moves\": " << phase.GeometryMoves << " }";
+            }
+            os << "\n      ]\n";
+            os << "    }";
+        }
+        os << "\n  ]\n";
+        os << "}\n";
+    }
+}
+
+#if defined(BENCHMARK_MALLOC_HOOKS)
+extern "C" void* malloc(size_t size)
+{
+    CountAllocation(size);
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size)
+{
+    CountAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size)
+{
+    CountAllocation(size);
+    return __libc_realloc(ptr, size);
+}
+
+extern "C" void* memalign(size_t alignment, size_t size)
+{
+    CountAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" int posix_memalign(void** ptr, size_t alignment, size_t size)
+{
+    CountAllocation(size);
+    *ptr = __libc_memalign(alignment, size);
+    return *ptr ? 0 : ENOMEM;
+}
+
+extern "C" void* aligned_alloc(size_t alignment, size_t size)
+{
+    CountAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+#else
+void* operator new(size_t size)
+{
+    CountAllocation(size);
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+#endif
+
+int main(int argc, char** argv)
+{
+    int runs = 1;
+    std::string outputPath;
+    std::string tracePath;
+    bool verbose = false;
+    std::vector<std::filesystem::path> files;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        if (arg == "--runs" && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        }
+        else if (arg == "--trace" && i + 1 < argc) {
+            tracePath = argv[++i];
+        }
+        else if (arg == "--verbose") {
+            verbose = true;
+        }
+        else {
+            CollectFiles(arg, files);
+        }
+    }
+
+    if (files.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--runs N] [--output result.json] [--trace trace.json] [--verbose] <file|directory> [...]" << std::endl;
+        return 1;
+    }
+
+    // The import path reports every label, which would both skew timings and corrupt JSON on stdout
+    if (!verbose) {
+        Message::DefaultMessenger()->RemovePrinters(STANDARD_TYPE(Message_PrinterOStream));
+    }
+
+    std::vector<FileResult> results;
+    for (const std::filesystem::path& path : files) {
+        std::cerr << "Benchmarking " << path.string() << std::endl;
+        results.push_back(RunFile(path, runs));
+    }
+
+    if (outputPath.empty()) {
+        WriteJson(std::cout, results, runs);
+    }
+    else {
+        std::ofstream output(outputPath);
+        WriteJson(output, results, runs);
+    }
+    if (!tracePath.empty()) {
+        Trace::WriteChromeJson(tracePath.c_str());
+    }
+    return 0;
+}
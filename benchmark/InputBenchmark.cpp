@@ -0,0 +1,168 @@
+// Pointer input routing benchmark.
+// Replays a synthetic pointer event stream (hover, orbit and pan drags, wheel, interaction with an ImGui window)
+// through InputRouter into ImGui and an AIS_ViewController, and prints the per-event cost as JSON.
+//
+// Usage: Occt-Wasm-ImGui-input-benchmark [--events N] [--events-per-frame N]
+
+#include "InputRouter.hpp"
+
+#include <AIS_ViewController.hxx>
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    const Graphic3d_Vec2i s_CanvasSize(1920, 1080);
+    const Graphic3d_Vec2i s_PanelPos(20, 20);  // ImGui window covering the top left corner
+    const Graphic3d_Vec2i s_PanelSize(400, 300);
+
+    // Counts redraw requests instead of drawing
+    class ReplayController : public AIS_ViewController
+    {
+    public:
+        size_t RedrawRequests { 0 };
+
+        virtual void ProcessInput() override { ++RedrawRequests; }
+    };
+
+    PointerEvent MakeEvent(PointerEvent::Type type, const Graphic3d_Vec2i& position, Aspect_VKeyMouse buttons,
+                           Aspect_VKeyMouse button = Aspect_VKeyMouse_NONE)
+    {
+        PointerEvent event;
+        event.EventType = type;
+        event.Position = position;
+        event.Buttons = buttons;
+        event.Button = button;
+        return event;
+    }
+
+    void AddDrag(std::vector<PointerEvent>& events, std::mt19937& random, const Graphic3d_Vec2i& from, Aspect_VKeyMouse button)
+    {
+        std::uniform_int_distribution<int> step(-12, 12);
+        Graphic3d_Vec2i position = from;
+        events.push_back(MakeEvent(PointerEvent::Type::Down, position, button, button));
+        for (int i = 0; i < 60; ++i) {
+            position.x() = std::clamp(position.x() + step(random), 0, s_CanvasSize.x());
+            position.y() = std::clamp(position.y() + step(random), 0, s_CanvasSize.y());
+            events.push_back(MakeEvent(PointerEvent::Type::Move, position, button));
+        }
+        events.push_back(MakeEvent(PointerEvent::Type::Up, position, Aspect_VKeyMouse_NONE, button));
+    }
+
+    // Deterministic mix of interactions, a little over eventCount events
+    std::vector<PointerEvent> MakeReplay(size_t eventCount)
+    {
+        std::mt19937 random(42);
+        std::uniform_int_distribution<int> x(0, s_CanvasSize.x());
+        std::uniform_int_distribution<int> y(0, s_CanvasSize.y());
+        std::uniform_int_distribution<int> kind(0, 9);
+
+        std::vector<PointerEvent> events;
+        events.reserve(eventCount + 64);
+        while (events.size() < eventCount) {
+            const Graphic3d_Vec2i position(x(random), y(random));
+            const int gesture = kind(random);
+            if (gesture < 5) {  // Hover
+                events.push_back(MakeEvent(PointerEvent::Type::Move, position, Aspect_VKeyMouse_NONE));
+            }
+            else if (gesture < 7) {
+                AddDrag(events, random, position, Aspect_VKeyMouse_LeftButton);
+            }
+            else if (gesture < 8) {
+                AddDrag(events, random, position, Aspect_VKeyMouse_MiddleButton);
+            }
+            else if (gesture < 9) {
+                PointerEvent wheel = MakeEvent(PointerEvent::Type::Wheel, position, Aspect_VKeyMouse_NONE);
+                wheel.WheelDelta = position.x() % 2 == 0 ? 1.0 : -1.0;
+                events.push_back(wheel);
+            }
+            else {  // Drag starting on the ImGui window
+                AddDrag(events, random, s_PanelPos + s_PanelSize / 2, Aspect_VKeyMouse_LeftButton);
+            }
+        }
+        return events;
+    }
+
+    void DrawUiFrame()
+    {
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(static_cast<float>(s_PanelPos.x()), static_cast<float>(s_PanelPos.y())));
+        ImGui::SetNextWindowSize(ImVec2(static_cast<float>(s_PanelSize.x()), static_cast<float>(s_PanelSize.y())));
+        ImGui::Begin("Panel");
+        ImGui::Text("Replay");
+        ImGui::End();
+        ImGui::Render();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t eventCount = 200000;
+    int eventsPerFrame = 8;  // Pointer events coalesced into one animation frame
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg(argv[i]);
+        if (arg == "--events" && i + 1 < argc) {
+            eventCount = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--events-per-frame" && i + 1 < argc) {
+            eventsPerFrame = std::max(1, std::atoi(argv[++i]));
+        }
+        else {
+            std::cerr << "Usage: " << argv[0] << " [--events N] [--events-per-frame N]" << std::endl;
+            return 1;
+        }
+    }
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(static_cast<float>(s_CanvasSize.x()), static_cast<float>(s_CanvasSize.y()));
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+
+    const std::vector<PointerEvent> events = MakeReplay(eventCount);
+    ReplayController controller;
+    InputRouter router;
+    router.SetCanvasSize(s_CanvasSize);
+
+    std::vector<double> frameDispatchUs;  // Dispatch time of the events of each frame
+    double totalMs = 0.0;
+    DrawUiFrame();
+    for (size_t first = 0; first < events.size(); first += eventsPerFrame) {
+        const size_t last = std::min(events.size(), first + eventsPerFrame);
+        const auto begin = std::chrono::steady_clock::now();
+        for (size_t i = first; i < last; ++i) {
+            router.Dispatch(events[i], controller);
+        }
+        const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        totalMs += elapsedMs;
+        frameDispatchUs.push_back(elapsedMs * 1000.0);
+        DrawUiFrame();  // Consumes the queued ImGui events and updates WantCaptureMouse
+    }
+    ImGui::DestroyContext();
+
+    std::sort(frameDispatchUs.begin(), frameDispatchUs.end());
+    const InputRouter::Stats& stats = router.GetStats();
+    std::cout << "{\n"
+              << "  \"events\": " << stats.EventCount << ",\n"
+              << "  \"ui_events\": " << stats.UiEventCount << ",\n"
+              << "  \"view_events\": " << stats.ViewEventCount << ",\n"
+              << "  \"redraw_requests\": " << controller.RedrawRequests << ",\n"
+              << "  \"ns_per_event\": " << totalMs * 1.0e6 / stats.EventCount << ",\n"
+              << "  \"frame_dispatch_p50_us\": " << frameDispatchUs[frameDispatchUs.size() / 2] << ",\n"
+              << "  \"frame_dispatch_p99_us\": " << frameDispatchUs[frameDispatchUs.size() * 99 / 100] << "\n"
+              << "}" << std::endl;
+    return 0;
+}
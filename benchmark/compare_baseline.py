@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""Compare an import benchmark result against a stored baseline.
+
+Usage: compare_baseline.py baseline.json result.json [--tolerance 0.10] [--min-ms 1.0]
+
+Exits with status 1 if any phase got slower (wall or CPU time), allocates or
+moves Geometry objects more than the tolerance allows. Phases faster than --min-ms in the baseline are
+only checked for allocations, their timings are too noisy.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    phases = {}
+    for entry in data["files"]:
+        for phase in entry["phases"]:
+            phases[(entry["file"], phase["name"])] = phase
+    return data, phases
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("baseline")
+    parser.add_argument("result")
+    parser.add_argument("--tolerance", type=float, default=0.10)
+    parser.add_argument("--min-ms", type=float, default=1.0)
+    args = parser.parse_args()
+
+    baseline_data, baseline = load(args.baseline)
+    result_data, result = load(args.result)
+    if baseline_data.get("occt_version") != result_data.get("occt_version"):
+        print("note: OCCT version changed ({} -> {})".format(
+            baseline_data.get("occt_version"), result_data.get("occt_version")))
+
+    regressions = 0
+    for key, new in sorted(result.items()):
+        old = baseline.get(key)
+        if old is None:
+            print("new    {} [{}]".format(*key))
+            continue
+
+        checks = [("allocations", old["allocations"], new["allocations"])]
+        if "geometry_moves" in old:
+            checks.append(("geometry_moves", old["geometry_moves"], new["geometry_moves"]))
+        if old["wall_ms"] >= args.min_ms:
+            checks.append(("wall_ms", old["wall_ms"], new["wall_ms"]))
+            checks.append(("cpu_ms", old["cpu_ms"], new["cpu_ms"]))
+
+        for metric, before, after in checks:
+            if before > 0 and after > before * (1.0 + args.tolerance):
+                regressions += 1
+                print("SLOWER {} [{}] {}: {:.3f} -> {:.3f} (+{:.1f}%)".format(
+                    key[0], key[1], metric, before, after, 100.0 * (after - before) / before))
+
+    for key in sorted(set(baseline) - set(result)):
+        print("gone   {} [{}]".format(*key))
+
+    print("{} regression(s)".format(regressions))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
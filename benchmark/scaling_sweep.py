@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""Sweep synthetic model sizes through the import benchmark.
+
+Usage: scaling_sweep.py <build-dir> <layout> <sizes> [--faces K] [--format step|brep] [--runs N] [--csv out.csv] [--plot out.png]
+
+  layout  flat | deep | instances | faces | fasteners (the generator layouts)
+  sizes   comma separated list, used as --count (or --depth for deep)
+
+Generates one model per size, benchmarks it and prints one CSV row per
+(size, phase). --plot needs matplotlib.
+"""
+
+import argparse
+import csv
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+PROJECT = "Occt-Wasm-ImGui"
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("build_dir")
+    parser.add_argument("layout", choices=["flat", "deep", "instances", "faces", "fasteners"])
+    parser.add_argument("sizes")
+    parser.add_argument("--faces", type=int, default=6)
+    parser.add_argument("--format", choices=["step", "brep"], default="step")
+    parser.add_argument("--runs", type=int, default=3)
+    parser.add_argument("--csv")
+    parser.add_argument("--plot")
+    args = parser.parse_args()
+
+    generator = os.path.join(args.build_dir, PROJECT + "-generator")
+    benchmark = os.path.join(args.build_dir, PROJECT + "-benchmark")
+    sizes = [int(size) for size in args.sizes.split(",")]
+
+    rows = []
+    with tempfile.TemporaryDirectory() as workdir:
+        for size in sizes:
+            model = os.path.join(workdir, "{}_{}.{}".format(args.layout, size, args.format))
+            command = [generator, args.layout]
+            if args.layout == "deep":
+                command += ["--depth", str(size)]
+            else:
+                command += ["--count", str(size)]
+            if args.layout == "faces":
+                command += ["--faces", str(args.faces)]
+            subprocess.check_call(command + [model])
+
+            result = json.loads(subprocess.check_output([benchmark, "--runs", str(args.runs), model]))
+            entry = result["files"][0]
+            for phase in entry["phases"]:
+                rows.append({
+                    "layout": args.layout, "size": size, "geometries": entry["geometries"],
+                    "phase": phase["name"], "wall_ms": phase["wall_ms"], "cpu_ms": phase["cpu_ms"],
+                    "peak_rss_kb": phase["peak_rss_kb"], "rss_delta_kb": phase["rss_delta_kb"], "allocations": phase["allocations"],
+                })
+
+    out = open(args.csv, "w", newline="") if args.csv else sys.stdout
+    writer = csv.DictWriter(out, fieldnames=list(rows[0].keys()))
+    writer.writeheader()
+    writer.writerows(rows)
+    if args.csv:
+        out.close()
+
+    if args.plot:
+        import matplotlib
+        matplotlib.use("Agg")
+        import matplotlib.pyplot as plt
+        for phase in dict.fromkeys(row["phase"] for row in rows):
+            points = [(row["size"], row["wall_ms"]) for row in rows if row["phase"] == phase]
+            plt.plot([p[0] for p in points], [p[1] for p in points], marker="o", label=phase)
+        plt.xscale("log")
+        plt.yscale("log")
+        plt.xlabel("depth" if args.layout == "deep" else "count")
+        plt.ylabel("wall ms")
+        plt.title("{} scaling".format(args.layout))
+        plt.legend()
+        plt.savefig(args.plot)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,5 +1,12 @@
 #include "AppManager.hpp"
 #include "GeometryManager.hpp"
+#include "DisplaySink.hpp"
+#include "Geometry.hpp"
+#include "LCRSTree.hpp"
+#include "Trace.hpp"
+
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
 
 
 AppManager& AppManager::GetInstance()
@@ -10,7 +17,8 @@ AppManager& AppManager::GetInstance()
 
 AppManager::AppManager()
 {
-    m_pGeometryManager = new GeometryManager();
+    m_pDisplaySink = new NullDisplaySink();
+    m_pGeometryManager = new GeometryManager(m_pDisplaySink);
 }
 
 AppManager::~AppManager()
@@ -19,19 +27,37 @@ AppManager::~AppManager()
         delete m_pGeometryManager;
         m_pGeometryManager = nullptr;
     }
+    if (m_pDisplaySink) {
+        delete m_pDisplaySink;
+        m_pDisplaySink = nullptr;
+    }
+}
+
+void AppManager::SetDisplaySink(DisplaySink* pDisplaySink)
+{
+    if (!pDisplaySink || pDisplaySink == m_pDisplaySink) return;
+
+    m_pGeometryManager->SetDisplaySink(pDisplaySink);
+    delete m_pDisplaySink;
+    m_pDisplaySink = pDisplaySink;
 }
 
 void AppManager::ImportGeometry(const char* fileName, std::istream& istream, GeomFileType fileType)
 {
+    TRACE_SCOPE("AppManager::ImportGeometry");
+    bool imported = false;
     if (fileType == GeomFileType::BREP) {
-
+        imported = m_pGeometryManager->ImportBRepFile(fileName, istream);
     }
     else if (fileType == GeomFileType::STEP) {
-        m_pGeometryManager->ImportStepFile(fileName, istream);
-        m_pGeometryManager->DisplayAllGeometry();
-        m_pGeometryManager->CreateAllGeometryIndexMap();
-        m_pGeometryManager->PrintAllGeometryName();
+        imported = m_pGeometryManager->ImportStepFile(fileName, istream);
     }
+    if (!imported) return;
+
+    m_pGeometryManager->DisplayAllGeometry();
+    m_pGeometryManager->CreateAllGeometryIndexMap();
+    m_pGeometryManager->BuildBoundingVolumeHierarchy();
+    m_pGeometryManager->PrintAllGeometryName();
 }
 
 void AppManager::SelectVertexMode()
@@ -52,4 +78,113 @@ void AppManager::SelectFaceMode()
 void AppManager::SelectSolidMode()
 {
     m_pGeometryManager->SelectSolidMode();
+}
+
+bool AppManager::TranslateGeometry(std::string_view name, double dx, double dy, double dz)
+{
+    LCRSNode<Geometry>* node = m_pGeometryManager->FindGeometryByName(name);
+    if (!node) return false;
+
+    gp_Trsf delta;
+    delta.SetTranslation(gp_Vec(dx, dy, dz));
+    m_pGeometryManager->MoveGeometry(node, delta);
+    return true;
+}
+
+bool AppManager::SetGeometryVisible(std::string_view name, bool visible)
+{
+    LCRSNode<Geometry>* node = m_pGeometryManager->FindGeometryByName(name);
+    if (!node) return false;
+
+    m_pGeometryManager->SetGeometryVisible(node, visible);
+    return true;
+}
+
+Bnd_Box AppManager::GetSceneBounds() const
+{
+    return m_pGeometryManager->GetSceneBounds();
+}
+
+Bnd_Box AppManager::GetSelectionBounds() const
+{
+    return m_pGeometryManager->GetSelectionBounds();
+}
+
+void AppManager::QueryRegion(const Bnd_Box& region, std::vector<int>& geometryIDs) const
+{
+    m_pGeometryManager->QueryRegion(region, geometryIDs);
+}
+
+void AppManager::GetDisplayedGeometry(std::vector<DisplayedGeometry>& geometries) const
+{
+    m_pGeometryManager->GetDisplayedGeometry(geometries);
+}
+
+bool AppManager::CollectGeometryShapes(std::string_view name, std::vector<Handle(AIS_InteractiveObject)>& objects) const
+{
+    LCRSNode<Geometry>* node = m_pGeometryManager->FindGeometryByName(name);
+    if (!node) return false;
+
+    m_pGeometryManager->CollectShapes(node, objects);
+    return true;
+}
+
+void AppManager::GetMemoryReport(std::vector<GeometryMemoryInfo>& report) const
+{
+    m_pGeometryManager->GetMemoryReport(report);
+}
+
+void AppManager::WriteMemoryReportJson(std::ostream& os) const
+{
+    m_pGeometryManager->WriteMemoryReportJson(os);
+}
+
+void AppManager::SetMemoryBudget(size_t bytes)
+{
+    m_pGeometryManager->SetMemoryBudget(bytes);
+}
+
+const MemoryGovernor::Stats& AppManager::GetMemoryGovernorStats() const
+{
+    return m_pGeometryManager->GetMemoryGovernorStats();
+}
+
+bool AppManager::EnablePartStore(const std::string& directory)
+{
+    return m_pGeometryManager->EnablePartStore(directory);
+}
+
+const PartStore::Stats& AppManager::GetPartStoreStats() const
+{
+    return m_pGeometryManager->GetPartStoreStats();
+}
+
+void AppManager::SetMergedStatic(bool enabled)
+{
+    m_pGeometryManager->SetMergedStatic(enabled);
+}
+
+bool AppManager::IsMergedStatic() const
+{
+    return m_pGeometryManager->IsMergedStatic();
+}
+
+void AppManager::SetPlanarWithoutNormals(bool enabled)
+{
+    m_pGeometryManager->SetPlanarWithoutNormals(enabled);
+}
+
+const MergedBatchStats& AppManager::GetMergedBatchStats() const
+{
+    return m_pGeometryManager->GetMergedBatchStats();
+}
+
+const std::vector<float>& AppManager::GetInstanceMatrices() const
+{
+    return m_pGeometryManager->GetInstanceMatrices();
+}
+
+const std::vector<int>& AppManager::GetInstanceGeometryIDs() const
+{
+    return m_pGeometryManager->GetInstanceGeometryIDs();
 }
\ No newline at end of file
@@ -1,6 +1,19 @@
+#include <Bnd_Box.hxx>
+
+#include "MemoryGovernor.hpp"
+#include "PartStore.hpp"
+
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
 
 class GeometryManager;
+struct DisplayedGeometry;
+struct GeometryMemoryInfo;
+struct MergedBatchStats;
+class DisplaySink;
+class AIS_InteractiveObject;
 
 
 enum class GeomFileType
@@ -15,6 +28,10 @@ public:
     static AppManager& GetInstance();
     ~AppManager();
 
+    // Takes ownership. A NullDisplaySink is installed until the viewer provides its own.
+    void SetDisplaySink(DisplaySink* pDisplaySink);
+    DisplaySink* GetDisplaySink() const { return m_pDisplaySink; }
+
     void ImportGeometry(const char* fileName, std::istream& istream, GeomFileType fileType);
     
     void SelectVertexMode();
@@ -22,10 +39,46 @@ public:
     void SelectFaceMode();
     void SelectSolidMode();
 
+    // Moves the named geometry and its subtree, returns false if no geometry has this name
+    bool TranslateGeometry(std::string_view name, double dx, double dy, double dz);
+
+    // Hides or shows the named geometry and its subtree, returns false if no geometry has this name
+    bool SetGeometryVisible(std::string_view name, bool visible);
+
+    // Spatial queries over the imported geometry, answered by its bounding volume hierarchy
+    Bnd_Box GetSceneBounds() const;
+    Bnd_Box GetSelectionBounds() const;
+    void QueryRegion(const Bnd_Box& region, std::vector<int>& geometryIDs) const;
+    void GetDisplayedGeometry(std::vector<DisplayedGeometry>& geometries) const;
+    // Appends the objects of the named geometry and its subtree, returns false if no geometry has this name
+    bool CollectGeometryShapes(std::string_view name, std::vector<Handle(AIS_InteractiveObject)>& objects) const;
+
+    // Per-geometry memory footprint, see GeometryManager::GetMemoryReport()
+    void GetMemoryReport(std::vector<GeometryMemoryInfo>& report) const;
+    void WriteMemoryReportJson(std::ostream& os) const;
+
+    // Budget for rendering resources of erased geometry, see GeometryManager::SetMemoryBudget()
+    void SetMemoryBudget(size_t bytes);
+    const MemoryGovernor::Stats& GetMemoryGovernorStats() const;
+
+    // Evicted parts go to blobs in directory, see GeometryManager::EnablePartStore()
+    bool EnablePartStore(const std::string& directory);
+    const PartStore::Stats& GetPartStoreStats() const;
+
+    // Per-color merged batches instead of one object per solid, see GeometryManager::SetMergedStatic()
+    void SetMergedStatic(bool enabled);
+    bool IsMergedStatic() const;
+    void SetPlanarWithoutNormals(bool enabled);
+    const MergedBatchStats& GetMergedBatchStats() const;
+
+    const std::vector<float>& GetInstanceMatrices() const;
+    const std::vector<int>& GetInstanceGeometryIDs() const;
+
 private:
     AppManager();
     AppManager(const AppManager& other) = delete;
     AppManager& operator=(const AppManager& other) = delete;
 
     GeometryManager* m_pGeometryManager;
+    DisplaySink* m_pDisplaySink;
 };
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "DisplaySink.hpp"
+
+#include <algorithm>
+
+
+void RecordingDisplaySink::Display(const Handle(AIS_InteractiveObject)& object)
+{
+    ++m_DisplayCount;
+    auto it = std::lower_bound(m_DisplayedObjects.begin(), m_DisplayedObjects.end(), object.get());
+    if (it == m_DisplayedObjects.end() || *it != object.get()) {
+        m_DisplayedObjects.insert(it, object.get());
+    }
+}
+
+void RecordingDisplaySink::Erase(const Handle(AIS_InteractiveObject)& object)
+{
+    ++m_EraseCount;
+    auto it = std::lower_bound(m_DisplayedObjects.begin(), m_DisplayedObjects.end(), object.get());
+    if (it != m_DisplayedObjects.end() && *it == object.get()) {
+        m_DisplayedObjects.erase(it);
+    }
+}
+
+void RecordingDisplaySink::ReleaseResources(const Handle(AIS_InteractiveObject)& object)
+{
+    ++m_ReleaseCount;
+}
+
+void RecordingDisplaySink::SetLocation(const Handle(AIS_InteractiveObject)& object, const TopLoc_Location& location)
+{
+    ++m_LocationCount;
+}
+
+void RecordingDisplaySink::SetSelectionMode(const Handle(AIS_InteractiveObject)& object, TopAbs_ShapeEnum oldMode, TopAbs_ShapeEnum newMode)
+{
+    ++m_SelectionModeCount;
+}
+
+void RecordingDisplaySink::GetSelectedObjects(std::vector<const AIS_InteractiveObject*>& objects) const
+{
+    objects.insert(objects.end(), m_SelectedObjects.begin(), m_SelectedObjects.end());
+}
+
+bool RecordingDisplaySink::IsDisplayed(const AIS_InteractiveObject* object) const
+{
+    return std::binary_search(m_DisplayedObjects.begin(), m_DisplayedObjects.end(), object);
+}
+
+void RecordingDisplaySink::Reset()
+{
+    m_DisplayedObjects.clear();
+    m_SelectedObjects.clear();
+    m_DisplayCount = 0;
+    m_EraseCount = 0;
+    m_ReleaseCount = 0;
+    m_LocationCount = 0;
+    m_SelectionModeCount = 0;
+    m_UpdateCount = 0;
+}
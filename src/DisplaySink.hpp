@@ -0,0 +1,86 @@
+#pragma once
+
+#include <AIS_InteractiveObject.hxx>
+#include <TopAbs_ShapeEnum.hxx>
+#include <TopLoc_Location.hxx>
+
+#include <vector>
+
+
+// Everything GeometryManager needs from a viewer.
+// The web build forwards to the AIS_InteractiveContext of WasmOcctView,
+// native builds use NullDisplaySink or RecordingDisplaySink so the import path runs headless.
+class DisplaySink
+{
+public:
+    virtual ~DisplaySink() = default;
+
+    virtual void Display(const Handle(AIS_InteractiveObject)& object) = 0;
+    virtual void Erase(const Handle(AIS_InteractiveObject)& object) = 0;
+    // Frees presentations and selection structures of an erased object, the next Display() recomputes them
+    virtual void ReleaseResources(const Handle(AIS_InteractiveObject)& object) = 0;
+    virtual void SetLocation(const Handle(AIS_InteractiveObject)& object, const TopLoc_Location& location) = 0;
+
+    // Replaces the active selection mode of object (modes are TopAbs shape types)
+    virtual void SetSelectionMode(const Handle(AIS_InteractiveObject)& object, TopAbs_ShapeEnum oldMode, TopAbs_ShapeEnum newMode) = 0;
+    virtual void GetSelectedObjects(std::vector<const AIS_InteractiveObject*>& objects) const = 0;
+    // Geometry IDs of the selected parts of merged batches, which are picked below object level (see MergedBatch)
+    virtual void GetSelectedPartIDs(std::vector<int>& geometryIDs) const {}
+
+    // Called once after a batch of changes
+    virtual void Update() = 0;
+
+    // Bytes of primitive arrays/GPU buffers held by the computed presentations of object (0 without a renderer)
+    virtual size_t EstimatePresentationBytes(const Handle(AIS_InteractiveObject)& object) const { return 0; }
+};
+
+class NullDisplaySink : public DisplaySink
+{
+public:
+    void Display(const Handle(AIS_InteractiveObject)& object) override {}
+    void Erase(const Handle(AIS_InteractiveObject)& object) override {}
+    void ReleaseResources(const Handle(AIS_InteractiveObject)& object) override {}
+    void SetLocation(const Handle(AIS_InteractiveObject)& object, const TopLoc_Location& location) override {}
+    void SetSelectionMode(const Handle(AIS_InteractiveObject)& object, TopAbs_ShapeEnum oldMode, TopAbs_ShapeEnum newMode) override {}
+    void GetSelectedObjects(std::vector<const AIS_InteractiveObject*>& objects) const override {}
+    void Update() override {}
+};
+
+// Counts every call and keeps the set of displayed objects, for headless runs and benchmarks
+class RecordingDisplaySink : public DisplaySink
+{
+public:
+    void Display(const Handle(AIS_InteractiveObject)& object) override;
+    void Erase(const Handle(AIS_InteractiveObject)& object) override;
+    void ReleaseResources(const Handle(AIS_InteractiveObject)& object) override;
+    void SetLocation(const Handle(AIS_InteractiveObject)& object, const TopLoc_Location& location) override;
+    void SetSelectionMode(const Handle(AIS_InteractiveObject)& object, TopAbs_ShapeEnum oldMode, TopAbs_ShapeEnum newMode) override;
+    void GetSelectedObjects(std::vector<const AIS_InteractiveObject*>& objects) const override;
+    void Update() override { ++m_UpdateCount; }
+
+    // Selection is simulated, there is no picking without a view
+    void SetSelectedObjects(const std::vector<const AIS_InteractiveObject*>& objects) { m_SelectedObjects = objects; }
+
+    size_t GetDisplayedCount() const { return m_DisplayedObjects.size(); }
+    bool IsDisplayed(const AIS_InteractiveObject* object) const;
+
+    size_t GetDisplayCount() const { return m_DisplayCount; }
+    size_t GetEraseCount() const { return m_EraseCount; }
+    size_t GetReleaseCount() const { return m_ReleaseCount; }
+    size_t GetLocationCount() const { return m_LocationCount; }
+    size_t GetSelectionModeCount() const { return m_SelectionModeCount; }
+    size_t GetUpdateCount() const { return m_UpdateCount; }
+
+    void Reset();
+
+private:
+    std::vector<const AIS_InteractiveObject*> m_DisplayedObjects;  // Sorted
+    std::vector<const AIS_InteractiveObject*> m_SelectedObjects;
+
+    size_t m_DisplayCount { 0 };
+    size_t m_EraseCount { 0 };
+    size_t m_ReleaseCount { 0 };
+    size_t m_LocationCount { 0 };
+    size_t m_SelectionModeCount { 0 };
+    size_t m_UpdateCount { 0 };
+};
@@ -0,0 +1,38 @@
+#include "DynamicResolution.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+float DynamicResolution::Update(bool isMoving, double nowMs)
+{
+    if (!m_Settings.Enabled) return SetScale(1.0f);
+
+    if (isMoving) {
+        m_LastMotionMs = nowMs;
+    }
+    else if (nowMs - m_LastMotionMs >= m_Settings.RestDelayMs) {
+        return SetScale(1.0f);
+    }
+
+    float scale = std::min(m_Scale, m_Settings.MotionScale);
+    if (m_LastRedrawMs > m_Settings.TargetRedrawMs) {
+        // Redraw time follows the pixel count, the square of the scale
+        scale *= static_cast<float>(std::sqrt(m_Settings.TargetRedrawMs / m_LastRedrawMs));
+    }
+    else if (m_LastRedrawMs > 0.0 && m_LastRedrawMs < 0.6 * m_Settings.TargetRedrawMs) {
+        scale += s_ScaleStep;  // Recover slowly so the scale does not oscillate
+    }
+    m_LastRedrawMs = 0.0;
+    return SetScale(std::clamp(scale, m_Settings.MinScale, m_Settings.MotionScale));
+}
+
+float DynamicResolution::SetScale(float scale)
+{
+    scale = std::max(s_ScaleStep, std::floor(scale / s_ScaleStep) * s_ScaleStep);
+    if (scale != m_Scale) {
+        m_Scale = scale;
+        ++m_ChangeCount;
+    }
+    return m_Scale;
+}
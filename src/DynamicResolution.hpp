@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+
+
+// Chooses the render resolution scale of the 3D view (Graphic3d_RenderingParams::RenderResolutionScale).
+// While the camera moves the scale drops to MotionScale and lower still when redraws exceed the target time,
+// the view is rendered at full resolution again once the camera has been at rest for RestDelayMs.
+class DynamicResolution
+{
+public:
+    struct Settings
+    {
+        bool Enabled { false };
+        double TargetRedrawMs { 16.0 };  // 3D redraw time to stay under while moving
+        float MinScale { 0.5f };
+        float MotionScale { 0.75f };     // Upper bound while moving
+        double RestDelayMs { 150.0 };
+    };
+
+    Settings& ChangeSettings() { return m_Settings; }
+    const Settings& GetSettings() const { return m_Settings; }
+
+    // Duration of a full 3D redraw at the current scale
+    void AddRedrawSample(double ms) { m_LastRedrawMs = ms; }
+    // Returns the scale for the coming redraw
+    float Update(bool isMoving, double nowMs);
+
+    float GetScale() const { return m_Scale; }
+    size_t GetChangeCount() const { return m_ChangeCount; }
+
+private:
+    static constexpr float s_ScaleStep = 0.125f;  // Scales are quantized, each change reallocates the offscreen buffers
+
+    Settings m_Settings;
+    float m_Scale { 1.0f };
+    double m_LastRedrawMs { 0.0 };  // 0: no sample since the last update
+    double m_LastMotionMs { 0.0 };
+    size_t m_ChangeCount { 0 };
+
+    float SetScale(float scale);
+};
@@ -8,64 +8,87 @@
 #include <TopoDS_Face.hxx>
 #include <TopExp.hxx>
 
+#include <string>
+#include <utility>
+
 
 int Geometry::s_LastID = 0;
+size_t Geometry::s_MoveCount = 0;
 
-Geometry::Geometry(const char* name)
-    : m_ID(s_LastID++), m_Name(name), m_AISShape(nullptr)
+Geometry::Geometry(std::string_view name)
+    : m_ID(s_LastID++), m_NameID(StringTable::GetInstance().Intern(name)), m_AISShape(nullptr)
 {
 }
 
-Geometry::Geometry(const char* name, Handle(AIS_ColoredShape) shape)
-    : m_ID(s_LastID++), m_Name(name), m_AISShape(shape)
+Geometry::Geometry(std::string_view name, Handle(AIS_ColoredShape) shape)
+    : m_ID(s_LastID++), m_NameID(StringTable::GetInstance().Intern(name)), m_AISShape(shape)
 {
 }
 
-Geometry::Geometry(const Geometry& other)
-    : m_ID(other.m_ID), m_Name(other.m_Name), m_AISShape(other.m_AISShape)
+Geometry::Geometry(const Geometry* parent, int tag)
+    : m_ID(s_LastID++), m_NameID(StringTable::InvalidID), m_pParent(parent), m_Tag(tag), m_AISShape(nullptr)
 {
 }
 
-Geometry::Geometry(Geometry&& other)
-    : m_ID(other.m_ID), m_Name(std::move(other.m_Name)), m_AISShape(other.m_AISShape)
+Geometry::Geometry(Geometry&& other) noexcept
+    : m_ID(other.m_ID), m_NameID(other.m_NameID), m_EntryID(other.m_EntryID),
+      m_pParent(other.m_pParent), m_Tag(other.m_Tag), m_AISShape(std::move(other.m_AISShape)), m_Color(other.m_Color),
+      m_WorldLocation(other.m_WorldLocation), m_LocalLocation(other.m_LocalLocation), m_InstanceIndex(other.m_InstanceIndex),
+      m_LocalBox(other.m_LocalBox),
+      m_pVertexMap(std::move(other.m_pVertexMap)), m_pEdgeMap(std::move(other.m_pEdgeMap)), m_pFaceMap(std::move(other.m_pFaceMap))
 {
     other.m_ID = -1;
-    other.m_AISShape = nullptr;
+    other.m_NameID = StringTable::InvalidID;
+    other.m_pParent = nullptr;
+    other.m_AISShape.Nullify();
+    ++s_MoveCount;
 }
 
 Geometry::~Geometry()
 {
-    if (m_pVertexMap) {
-        delete m_pVertexMap;
-        m_pVertexMap = nullptr;
-    }
-    if (m_pEdgeMap) {
-        delete m_pEdgeMap;
-        m_pEdgeMap = nullptr;
-    }
-    if (m_pFaceMap) {
-        delete m_pFaceMap;
-        m_pFaceMap = nullptr;
-    }
-    if (!m_AISShape.IsNull()) m_AISShape.Nullify();
 }
 
-Geometry& Geometry::operator=(const Geometry& other)
+Geometry& Geometry::operator=(Geometry&& other) noexcept
 {
+    if (this == &other) return *this;
+
     m_ID = other.m_ID;
-    m_Name = other.m_Name;
-    m_AISShape = other.m_AISShape;
+    m_NameID = other.m_NameID;
+    m_EntryID = other.m_EntryID;
+    m_pParent = other.m_pParent;
+    m_Tag = other.m_Tag;
+    m_AISShape = std::move(other.m_AISShape);
+    m_Color = other.m_Color;
+    m_WorldLocation = other.m_WorldLocation;
+    m_LocalLocation = other.m_LocalLocation;
+    m_InstanceIndex = other.m_InstanceIndex;
+    m_LocalBox = other.m_LocalBox;
+    m_pVertexMap = std::move(other.m_pVertexMap);
+    m_pEdgeMap = std::move(other.m_pEdgeMap);
+    m_pFaceMap = std::move(other.m_pFaceMap);
+
+    other.m_ID = -1;
+    other.m_NameID = StringTable::InvalidID;
+    other.m_pParent = nullptr;
+    other.m_AISShape.Nullify();
+    ++s_MoveCount;
+    return *this;
 }
 
-Geometry& Geometry::operator=(Geometry&& other)
+std::string_view Geometry::GetName() const
 {
-    m_ID = other.m_ID;
-    m_Name = std::move(other.m_Name);
-    m_AISShape = other.m_AISShape;
+    return StringTable::GetInstance().Get(GetNameID());
+}
 
-    other.m_ID = -1;
-    other.m_Name.clear();
-    other.m_AISShape = nullptr;
+StringTable::StringID Geometry::GetNameID() const
+{
+    if (m_NameID == StringTable::InvalidID && m_pParent) {
+        // Generated names are only built and interned the first time somebody asks for them
+        std::string name(m_pParent->GetName());
+        name += std::to_string(m_Tag);
+        m_NameID = StringTable::GetInstance().Intern(name);
+    }
+    return m_NameID;
 }
 
 bool Geometry::HasShape() const
@@ -78,6 +101,28 @@ void Geometry::SetColor(Quantity_Color color)
     m_Color = color;
 }
 
+void Geometry::SetEntry(std::string_view entry)
+{
+    m_EntryID = StringTable::GetInstance().Intern(entry);
+}
+
+void Geometry::SetWorldLocation(const TopLoc_Location& world, const TopLoc_Location& parentWorld)
+{
+    m_WorldLocation = world;
+    m_LocalLocation = parentWorld.Inverted() * world;
+}
+
+Bnd_Box Geometry::GetWorldBox() const
+{
+    return m_LocalBox.IsVoid() ? m_LocalBox : m_LocalBox.Transformed(GetWorldTransform());
+}
+
+void Geometry::SetLocations(const TopLoc_Location& world, const TopLoc_Location& local)
+{
+    m_WorldLocation = world;
+    m_LocalLocation = local;
+}
+
 void Geometry::SetShape(Handle(AIS_ColoredShape) shape)
 {
     m_AISShape = shape;
@@ -87,9 +132,9 @@ void Geometry::CreateIndexedMap()
 {
     if (m_AISShape.IsNull()) return;
 
-    m_pVertexMap = new TopTools_IndexedMapOfShape();
-    m_pEdgeMap = new TopTools_IndexedMapOfShape();
-    m_pFaceMap = new TopTools_IndexedMapOfShape();
+    m_pVertexMap.reset(new TopTools_IndexedMapOfShape());
+    m_pEdgeMap.reset(new TopTools_IndexedMapOfShape());
+    m_pFaceMap.reset(new TopTools_IndexedMapOfShape());
 
     // Referred Indexing Method in MeshGems Index
     int Face_ID = 0;
@@ -119,4 +164,11 @@ void Geometry::CreateIndexedMap()
                 m_pVertexMap->Add(TopoVertex2);
         }  // For Edge Iterator
     }  // For Face Iterator
-}
\ No newline at end of file
+}
+
+void Geometry::ReleaseIndexedMap()
+{
+    m_pVertexMap.reset();
+    m_pEdgeMap.reset();
+    m_pFaceMap.reset();
+}
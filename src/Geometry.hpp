@@ -3,8 +3,14 @@
 #include <Standard_Type.hxx>
 #include <Quantity_Color.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
+#include <TopLoc_Location.hxx>
+#include <Bnd_Box.hxx>
 
-#include <string>
+#include "StringTable.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
 
 class AIS_ColoredShape;
 
@@ -13,42 +19,66 @@ class Geometry
 {
 public:
     // Constructors
-    Geometry(const char* name);
-    Geometry(const char* name, Handle(AIS_ColoredShape) shape);
-    Geometry(const Geometry& other);  // Copy Constructor
-    Geometry(Geometry&& other);  // Move Constructor
+    explicit Geometry(std::string_view name);
+    Geometry(std::string_view name, Handle(AIS_ColoredShape) shape);
+    Geometry(const Geometry* parent, int tag);  // Name is generated lazily as parent name + tag
+    Geometry(const Geometry& other) = delete;  // Move-only: owns its index maps
+    Geometry(Geometry&& other) noexcept;  // Move Constructor
 
     // Destructors
     ~Geometry();
 
     // Operators
-    Geometry& operator=(const Geometry& other);  // Copy Operator
-    Geometry& operator=(Geometry&& other);  // Move Operator
+    Geometry& operator=(const Geometry& other) = delete;
+    Geometry& operator=(Geometry&& other) noexcept;  // Move Operator
     
     // Getters
     int GetID() const { return m_ID; }
-    std::string GetName() const { return m_Name; }
+    std::string_view GetName() const;
+    StringTable::StringID GetNameID() const;
+    std::string_view GetEntry() const { return StringTable::GetInstance().Get(m_EntryID); }
     Quantity_Color GetColor() const { return m_Color; }
     Handle(AIS_ColoredShape) GetShape() const { return m_AISShape; }
+    const TopLoc_Location& GetWorldLocation() const { return m_WorldLocation; }
+    const TopLoc_Location& GetLocalLocation() const { return m_LocalLocation; }  // Relative to the parent node
+    const gp_Trsf& GetWorldTransform() const { return m_WorldLocation.Transformation(); }
+    const Bnd_Box& GetLocalBox() const { return m_LocalBox; }  // In the untransformed shape frame
+    Bnd_Box GetWorldBox() const;
+    int GetInstanceIndex() const { return m_InstanceIndex; }  // -1 if this node is not a placed instance
     bool HasShape() const;
-    const TopTools_IndexedMapOfShape* GetVertexMap() const { return m_pVertexMap; }
-    const TopTools_IndexedMapOfShape* GetEdgeMap() const { return m_pEdgeMap; }
-    const TopTools_IndexedMapOfShape* GetFaceMap() const { return m_pFaceMap; }
+    const TopTools_IndexedMapOfShape* GetVertexMap() const { return m_pVertexMap.get(); }
+    const TopTools_IndexedMapOfShape* GetEdgeMap() const { return m_pEdgeMap.get(); }
+    const TopTools_IndexedMapOfShape* GetFaceMap() const { return m_pFaceMap.get(); }
+    static size_t GetMoveCount() { return s_MoveCount; }  // Moves of any geometry so far, copying is deleted
 
     // Setters
     void SetColor(Quantity_Color color);
+    void SetEntry(std::string_view entry);
+    void SetWorldLocation(const TopLoc_Location& world, const TopLoc_Location& parentWorld);
+    void SetLocations(const TopLoc_Location& world, const TopLoc_Location& local);
+    void SetInstanceIndex(int index) { m_InstanceIndex = index; }
+    void SetLocalBox(const Bnd_Box& box) { m_LocalBox = box; }
     void SetShape(Handle(AIS_ColoredShape) shape);
 
     void CreateIndexedMap();
+    void ReleaseIndexedMap();  // Until the next CreateIndexedMap()
 
 private:
     int m_ID;
-    std::string m_Name;
+    mutable StringTable::StringID m_NameID;
+    StringTable::StringID m_EntryID { StringTable::InvalidID };
+    const Geometry* m_pParent { nullptr };  // Only set for generated names
+    int m_Tag { 0 };
     Handle(AIS_ColoredShape) m_AISShape;
     Quantity_Color m_Color;
-    TopTools_IndexedMapOfShape* m_pVertexMap { nullptr };
-    TopTools_IndexedMapOfShape* m_pEdgeMap { nullptr };
-    TopTools_IndexedMapOfShape* m_pFaceMap { nullptr };
+    TopLoc_Location m_WorldLocation;
+    TopLoc_Location m_LocalLocation;
+    int m_InstanceIndex { -1 };
+    Bnd_Box m_LocalBox;
+    std::unique_ptr<TopTools_IndexedMapOfShape> m_pVertexMap;
+    std::unique_ptr<TopTools_IndexedMapOfShape> m_pEdgeMap;
+    std::unique_ptr<TopTools_IndexedMapOfShape> m_pFaceMap;
 
     static int s_LastID;
+    static size_t s_MoveCount;
 };
\ No newline at end of file
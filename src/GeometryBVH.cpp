@@ -0,0 +1,170 @@
+#include "GeometryBVH.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+
+void GeometryBVH::Build(std::vector<Item>&& items)
+{
+    Clear();
+    m_Items = std::move(items);
+    if (m_Items.empty()) return;
+
+    const int itemCount = static_cast<int>(m_Items.size());
+    m_ItemLeaf.assign(itemCount, -1);
+    m_ItemVisible.assign(itemCount, 1);
+
+    std::vector<gp_XYZ> centroids(itemCount);
+    for (int i = 0; i < itemCount; ++i) {
+        m_ItemIndex[m_Items[i].GeometryID] = i;
+        if (!m_Items[i].Box.IsVoid()) {
+            centroids[i] = (m_Items[i].Box.CornerMin().XYZ() + m_Items[i].Box.CornerMax().XYZ()) * 0.5;
+        }
+    }
+
+    std::vector<int> order(itemCount);
+    std::iota(order.begin(), order.end(), 0);
+    m_Nodes.reserve(2 * itemCount - 1);
+    BuildRecursive(order, 0, itemCount, -1, centroids);
+}
+
+void GeometryBVH::Clear()
+{
+    m_Nodes.clear();
+    m_Items.clear();
+    m_ItemLeaf.clear();
+    m_ItemVisible.clear();
+    m_ItemIndex.clear();
+}
+
+int GeometryBVH::BuildRecursive(std::vector<int>& order, int begin, int end, int parent, const std::vector<gp_XYZ>& centroids)
+{
+    const int nodeIndex = static_cast<int>(m_Nodes.size());
+    m_Nodes.emplace_back();
+    m_Nodes[nodeIndex].Parent = parent;
+
+    if (end - begin == 1) {
+        const int item = order[begin];
+        m_Nodes[nodeIndex].Item = item;
+        m_Nodes[nodeIndex].Box = m_Items[item].Box;
+        m_ItemLeaf[item] = nodeIndex;
+        return nodeIndex;
+    }
+
+    // Split at the median along the longest axis of the centroid bounds
+    gp_XYZ minPnt = centroids[order[begin]], maxPnt = minPnt;
+    for (int i = begin + 1; i < end; ++i) {
+        const gp_XYZ& c = centroids[order[i]];
+        minPnt.SetCoord(std::min(minPnt.X(), c.X()), std::min(minPnt.Y(), c.Y()), std::min(minPnt.Z(), c.Z()));
+        maxPnt.SetCoord(std::max(maxPnt.X(), c.X()), std::max(maxPnt.Y(), c.Y()), std::max(maxPnt.Z(), c.Z()));
+    }
+    const gp_XYZ extent = maxPnt - minPnt;
+    int axis = 1;
+    if (extent.Y() > extent.Coord(axis)) axis = 2;
+    if (extent.Z() > extent.Coord(axis)) axis = 3;
+
+    const int mid = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+        [&centroids, axis](int a, int b) { return centroids[a].Coord(axis) < centroids[b].Coord(axis); });
+
+    const int left = BuildRecursive(order, begin, mid, nodeIndex, centroids);
+    const int right = BuildRecursive(order, mid, end, nodeIndex, centroids);
+
+    Node& node = m_Nodes[nodeIndex];
+    node.Left = left;
+    node.Right = right;
+    node.Box = m_Nodes[left].Box;
+    node.Box.Add(m_Nodes[right].Box);
+    return nodeIndex;
+}
+
+void GeometryBVH::RefitFromLeaf(int itemIndex)
+{
+    int nodeIndex = m_ItemLeaf[itemIndex];
+    Node& leaf = m_Nodes[nodeIndex];
+    leaf.Box.SetVoid();
+    if (m_ItemVisible[itemIndex]) {
+        leaf.Box = m_Items[itemIndex].Box;
+    }
+
+    for (nodeIndex = leaf.Parent; nodeIndex >= 0; nodeIndex = m_Nodes[nodeIndex].Parent) {
+        Node& node = m_Nodes[nodeIndex];
+        node.Box = m_Nodes[node.Left].Box;
+        node.Box.Add(m_Nodes[node.Right].Box);
+    }
+}
+
+int GeometryBVH::FindItem(int geometryID) const
+{
+    auto it = m_ItemIndex.find(geometryID);
+    return it != m_ItemIndex.end() ? it->second : -1;
+}
+
+bool GeometryBVH::UpdateItem(int geometryID, const Bnd_Box& box)
+{
+    const int item = FindItem(geometryID);
+    if (item < 0) return false;
+
+    m_Items[item].Box = box;
+    RefitFromLeaf(item);
+    return true;
+}
+
+bool GeometryBVH::SetVisible(int geometryID, bool visible)
+{
+    const int item = FindItem(geometryID);
+    if (item < 0) return false;
+    if ((m_ItemVisible[item] != 0) == visible) return true;
+
+    m_ItemVisible[item] = visible ? 1 : 0;
+    RefitFromLeaf(item);
+    return true;
+}
+
+bool GeometryBVH::IsVisible(int geometryID) const
+{
+    const int item = FindItem(geometryID);
+    return item >= 0 && m_ItemVisible[item] != 0;
+}
+
+Bnd_Box GeometryBVH::GetBounds() const
+{
+    return m_Nodes.empty() ? Bnd_Box() : m_Nodes[0].Box;
+}
+
+Bnd_Box GeometryBVH::GetBounds(const std::vector<int>& geometryIDs) const
+{
+    Bnd_Box bounds;
+    for (int geometryID : geometryIDs) {
+        const int item = FindItem(geometryID);
+        if (item >= 0) bounds.Add(m_Items[item].Box);
+    }
+    return bounds;
+}
+
+const Bnd_Box* GeometryBVH::GetItemBox(int geometryID) const
+{
+    const int item = FindItem(geometryID);
+    return item >= 0 ? &m_Items[item].Box : nullptr;
+}
+
+void GeometryBVH::Query(const Bnd_Box& region, std::vector<int>& geometryIDs) const
+{
+    if (m_Nodes.empty() || region.IsVoid()) return;
+
+    int stack[64];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const Node& node = m_Nodes[stack[--stackSize]];
+        if (node.Box.IsVoid() || node.Box.IsOut(region)) continue;  // Hidden subtrees have void boxes
+
+        if (node.Item >= 0) {
+            geometryIDs.push_back(m_Items[node.Item].GeometryID);
+        }
+        else {
+            stack[stackSize++] = node.Left;
+            stack[stackSize++] = node.Right;
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Bnd_Box.hxx>
+
+#include <unordered_map>
+#include <vector>
+
+
+// Bounding volume hierarchy over the world-space boxes of geometry nodes.
+// Built once after import (median split on the longest centroid axis, one item per leaf) and
+// refitted along the leaf-to-root path when a single box or visibility changes.
+// Hidden items keep their box but contribute a void box to their ancestors.
+class GeometryBVH
+{
+public:
+    struct Item
+    {
+        int GeometryID;
+        Bnd_Box Box;
+    };
+
+    void Build(std::vector<Item>&& items);
+    void Clear();
+
+    bool IsEmpty() const { return m_Nodes.empty(); }
+    size_t GetItemCount() const { return m_Items.size(); }
+    size_t GetNodeCount() const { return m_Nodes.size(); }
+
+    // Refit only the path to the root, O(log n). Returns false for unknown geometry IDs.
+    bool UpdateItem(int geometryID, const Bnd_Box& box);
+    bool SetVisible(int geometryID, bool visible);
+    bool IsVisible(int geometryID) const;
+
+    // Bounds of all visible items, O(1)
+    Bnd_Box GetBounds() const;
+    // Union of the given items' boxes (visible or not), O(k)
+    Bnd_Box GetBounds(const std::vector<int>& geometryIDs) const;
+    const Bnd_Box* GetItemBox(int geometryID) const;
+    const std::vector<Item>& GetItems() const { return m_Items; }  // Visible or not
+
+    // Appends IDs of visible items whose box intersects region, O(log n + k)
+    void Query(const Bnd_Box& region, std::vector<int>& geometryIDs) const;
+
+private:
+    struct Node
+    {
+        Bnd_Box Box;
+        int Parent { -1 };
+        int Left { -1 };
+        int Right { -1 };
+        int Item { -1 };  // Item index for leaves, -1 for inner nodes
+    };
+
+    int BuildRecursive(std::vector<int>& order, int begin, int end, int parent, const std::vector<gp_XYZ>& centroids);
+    void RefitFromLeaf(int itemIndex);
+    int FindItem(int geometryID) const;
+
+    std::vector<Node> m_Nodes;  // m_Nodes[0] is the root
+    std::vector<Item> m_Items;
+    std::vector<int> m_ItemLeaf;
+    std::vector<char> m_ItemVisible;
+    std::unordered_map<int, int> m_ItemIndex;  // Geometry ID to item index
+};
@@ -1,7 +1,10 @@
 #include "GeometryManager.hpp"
 #include "Geometry.hpp"
 #include "LCRSTree.hpp"
-#include "WasmOcctView.hpp"
+#include "MergedBatch.hpp"
+#include "DisplaySink.hpp"
+#include "PartStore.hpp"
+#include "Trace.hpp"
 
 // OCCT
 #include <BinXCAFDrivers.hxx>
@@ -24,14 +27,26 @@
 #include <TopoDS_Vertex.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Face.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Solid.hxx>
+#include <TopoDS_TShape.hxx>
 #include <TopExp.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepTools.hxx>
+#include <BRep_Builder.hxx>
+#include <StdPrs_ToolTriangulatedShape.hxx>
 
 // Standard Libraries
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <string_view>
 #include <utility>
 
 
-GeometryManager::GeometryManager()
+GeometryManager::GeometryManager(DisplaySink* pDisplaySink)
+    : m_pDisplaySink(pDisplaySink), m_SelectionMode(TopAbs_SOLID)
 {
     m_pGeometryTree = new LCRSTree<Geometry>();
 
@@ -44,6 +59,9 @@ GeometryManager::GeometryManager()
 
 GeometryManager::~GeometryManager()
 {
+    // The application keeps open documents alive, close ours so it can be freed
+    if (!m_hStdDoc.IsNull() && m_hStdDoc->IsOpened()) m_hXCAFApp->Close(m_hStdDoc);
+
     if (m_pGeometryTree == nullptr) return;
     delete m_pGeometryTree;
     m_pGeometryTree = nullptr;
@@ -61,6 +79,37 @@ bool GeometryManager::ImportStepFile(const char* fileName, std::istream& istream
     return retStatus;
 }
 
+bool GeometryManager::ImportBRepFile(const char* fileName, std::istream& istream)
+{
+    if (!GetOCCDocFromBRepFile(fileName, istream)) {
+        return false;
+    }
+
+    return LoadGeometryFromOCCDoc();
+}
+
+bool GeometryManager::GetOCCDocFromBRepFile(const char* fileName, std::istream& istream)
+{
+    Message::DefaultMessenger()->Send(fileName, Message_Warning);
+
+    TopoDS_Shape aShape;
+    BRep_Builder builder;
+    {
+        TRACE_SCOPE("BRepTools::Read");
+        BRepTools::Read(aShape, istream, builder);
+    }
+    if (aShape.IsNull()) {
+        Message::DefaultMessenger()->Send("Not a valid BRep file", Message_Warning);
+        return false;
+    }
+
+    // Compounds are expanded into assemblies so every sub-shape gets its own label (and tree node)
+    Handle(XCAFDoc_ShapeTool) shapeTool = XCAFDoc_DocumentTool::ShapeTool(m_hStdDoc->Main());
+    shapeTool->AddShape(aShape, Standard_True);
+    Message::DefaultMessenger()->Send("Read BRep File done!", Message_Warning);
+    return true;
+}
+
 bool GeometryManager::GetOCCDocFromStepFile(const char* fileName, std::istream& istream)
 {
     Message::DefaultMessenger()->Send(fileName, Message_Warning);
@@ -69,7 +118,11 @@ bool GeometryManager::GetOCCDocFromStepFile(const char* fileName, std::istream&
     STEPControl_Reader& reader = readerCAF.ChangeReader();
     
     if (XCAFDoc_DocumentTool::IsXCAFDocument(m_hStdDoc)) {
-        IFSelect_ReturnStatus status = reader.ReadStream(fileName, istream);
+        IFSelect_ReturnStatus status;
+        {
+            TRACE_SCOPE("STEPCAFControl_Reader::ReadStream");
+            status = reader.ReadStream(fileName, istream);
+        }
         if (status != IFSelect_RetDone) {
             switch (status)
 		    {
@@ -92,7 +145,12 @@ bool GeometryManager::GetOCCDocFromStepFile(const char* fileName, std::istream&
                 // RetStop  : indicates end or stop (such as Raise)
 		    }
         }
-        if (!readerCAF.Transfer(m_hStdDoc)) {  // Transfer reader data to m_hStdDoc
+        bool transferred;
+        {
+            TRACE_SCOPE("STEPCAFControl_Reader::Transfer");
+            transferred = readerCAF.Transfer(m_hStdDoc);  // Transfer reader data to m_hStdDoc
+        }
+        if (!transferred) {
             Message::DefaultMessenger()->Send("Cannot read any relevant data from the STEP file", Message_Warning);
             return false;
         }
@@ -108,13 +166,30 @@ bool GeometryManager::LoadGeometryFromOCCDoc()
     TDF_Label shapeLabel = mainLabel.FindChild(mainLabel.Tag(), false);
     int shapeTag = shapeLabel.Tag();
 
-    Geometry rootGeometry("Root");
-    GEOMETRY_NODE rootNode = m_pGeometryTree->InsertItem(std::move(rootGeometry));
+    // Names of the previous model are not read again, EmplaceRoot() drops its tree right after
+    StringTable::GetInstance().Clear();
+    GEOMETRY_NODE rootNode = m_pGeometryTree->EmplaceRoot("Root");
+    m_InstanceMatrices.clear();
+    m_InstanceGeometryIDs.clear();
+    m_ObjectGeometryIDs.clear();
+    m_NodesByID.clear();
+    m_BVH.Clear();
+    m_MemoryGovernor.Clear();
+    m_PartIDs.clear();
+    m_ResidentPartUsers.clear();
+    m_PartInstanceCounts.clear();
+    m_ResidentParts.clear();
+    m_DehydratedIDs.clear();
+    m_PartStore.Clear();
     
     TopLoc_Location location;
     location.Identity();  // Set location to identity matrix
 
-    IterateFather(shapeLabel, rootNode, shapeTag, location);
+    {
+        TRACE_SCOPE("GeometryManager::IterateFather");
+        IterateFather(shapeLabel, rootNode, shapeTag, location);
+    }
+    AssignPartIDs();
 
 
     //std::string s = std::to_string(mainLabel.Tag());
@@ -125,10 +200,11 @@ bool GeometryManager::LoadGeometryFromOCCDoc()
     Message::DefaultMessenger()->Send(GetEntryString(mainLabel).ToCString(), Message_Warning);
     Message::DefaultMessenger()->Send(GetEntryString(shapeLabel).ToCString(), Message_Warning);
 
+    if (m_PartStore.IsOpen()) ReleaseSourceShapes();  // Labels above are invalid afterwards
     return true;
 }
 
-void GeometryManager::IterateFather(const TDF_Label& label, GEOMETRY_NODE node, const int tag, TopLoc_Location loc, bool callByTree)
+void GeometryManager::IterateFather(const TDF_Label& label, GEOMETRY_NODE node, const int tag, const TopLoc_Location& loc, bool callByTree)
 {
     Handle(XCAFDoc_ShapeTool) shapeTool = XCAFDoc_DocumentTool::ShapeTool(label);	
 	Handle(TDataStd_TreeNode) tree;
@@ -141,9 +217,7 @@ void GeometryManager::IterateFather(const TDF_Label& label, GEOMETRY_NODE node,
 		}
 		if (tree->HasFather()) {
 			// Calculate Location
-			TopLoc_Location thisLocation;
-			thisLocation = shapeTool->GetLocation(label);
-			thisLocation = loc * thisLocation;
+			const TopLoc_Location thisLocation = loc * shapeTool->GetLocation(label);
 			IterateFather(tree->Father()->Label(), node, tag, thisLocation, true); // call by tree
 			return;
 		}
@@ -161,7 +235,7 @@ void GeometryManager::IterateFather(const TDF_Label& label, GEOMETRY_NODE node,
 	}
 }
 
-GeometryManager::GEOMETRY_NODE GeometryManager::AddGeometryToTree(const TDF_Label& label, GEOMETRY_NODE node, const int tag, TopLoc_Location loc)
+GeometryManager::GEOMETRY_NODE GeometryManager::AddGeometryToTree(const TDF_Label& label, GEOMETRY_NODE node, const int tag, const TopLoc_Location& loc)
 {
     Handle(XCAFDoc_ShapeTool) shapeTool = XCAFDoc_DocumentTool::ShapeTool(label);
 	Handle(XCAFDoc_ColorTool) colorTool = XCAFDoc_DocumentTool::ColorTool(label);
@@ -172,25 +246,23 @@ GeometryManager::GEOMETRY_NODE GeometryManager::AddGeometryToTree(const TDF_Labe
 	bool isSubShape = false;
 	
     TCollection_AsciiString entryStr = GetEntryString(label);
-    std::string nameStr = GetNameString(label).ToCString();
+    TCollection_AsciiString nameAsciiStr = GetNameString(label);
+    std::string_view nameStr(nameAsciiStr.ToCString(), nameAsciiStr.Length());
 	//OutputDebugString(_T("Entry: ") + CString(entryStr) + _T(", Name: ") + CString(nameStr) + _T("\n"));
 
-    TCollection_AsciiString entryNameStr = TCollection_AsciiString("Entry: ") + entryStr + TCollection_AsciiString(", Name: ") + TCollection_AsciiString(nameStr.c_str()) + "\n";
+    TCollection_AsciiString entryNameStr = TCollection_AsciiString("Entry: ") + entryStr + TCollection_AsciiString(", Name: ") + nameAsciiStr + "\n";
     Message::DefaultMessenger()->Send(entryNameStr.ToCString(), Message_Warning);
 
-	if (nameStr != std::string("Shapes") && entryStr != TCollection_AsciiString("0:1:1")) { // If this Label is not 'Shape Label'
+	if (nameStr != "Shapes" && entryStr != TCollection_AsciiString("0:1:1")) { // If this Label is not 'Shape Label'
 		aShape = shapeTool->GetShape(label);
-		// If TDataStd_Name is Empty
-		if (nameStr.empty()) {
-			std::string geomName = node->GetData().GetName(); // Parent Name		
-			std::string geomNum = std::to_string(tag);
-            // CString geomNum;
-			// geomNum.Format(_T("%d"), tag);
-			nameStr = geomName + geomNum;
-		}		
-		// Make this Geometry Structure
-		//Geometry geom(tag, nameStr, entryStr);
-        Geometry geom(nameStr.c_str());
+		// Make this Geometry Structure in place
+		// If TDataStd_Name is empty, the name is derived from the parent name and tag on first use.
+        GEOMETRY_NODE newNode = nameStr.empty()
+            ? m_pGeometryTree->EmplaceChild(node, &node->GetData(), tag)
+            : m_pGeometryTree->EmplaceChild(node, nameStr);
+        Geometry& geom = newNode->GetData();
+        geom.SetEntry(std::string_view(entryStr.ToCString(), entryStr.Length()));
+        geom.SetWorldLocation(loc, node->GetData().GetWorldLocation());
 		//SubGeometry subGeom;
 		if (!aShape.IsNull()) {			
 			Quantity_Color col(Quantity_NOC_LIGHTGRAY); // Default Color is Light Gray
@@ -223,9 +295,17 @@ GeometryManager::GEOMETRY_NODE GeometryManager::AddGeometryToTree(const TDF_Labe
 				}
 			}
 			//if (!isSubShape) {
-				Handle(AIS_ColoredShape) shape = new AIS_ColoredShape(aShape);
-				// Locate this shape by calculated location data
-				shape->SetShape(shape->Shape().Located(loc));
+				Handle(AIS_ColoredShape) shape = new AIS_ColoredShape(aShape.Located(TopLoc_Location()));
+				// Place this shape relative to its parent object, which carries the rest of the location chain.
+				// Moving an assembly then only updates the parent transformation, children are not recomputed.
+				Handle(AIS_ColoredShape) parentShape = node->GetData().GetShape();
+				if (!parentShape.IsNull()) {
+					shape->SetLocalTransformation(geom.GetLocalLocation().Transformation());
+					parentShape->AddChild(shape);
+				}
+				else {
+					shape->SetLocalTransformation(geom.GetWorldTransform());
+				}
 				shape->SetColor(col); // Set Color to AIS_Shape
 				// Set Line Color by Shape's Color
 				Handle(Prs3d_LineAspect) lineAspect = new Prs3d_LineAspect(col, Aspect_TOL_SOLID, 2.0);
@@ -233,6 +313,9 @@ GeometryManager::GEOMETRY_NODE GeometryManager::AddGeometryToTree(const TDF_Labe
 				shape->Attributes()->SetFaceBoundaryDraw(Standard_True);
                 geom.SetColor(col);
 				geom.SetShape(shape);
+                geom.SetInstanceIndex(AddInstanceMatrix(geom));
+                m_ObjectGeometryIDs[shape.get()] = geom.GetID();
+                m_NodesByID[geom.GetID()] = newNode;
 			//}			
 		}
 		//if (!isSubShape) {
@@ -241,7 +324,7 @@ GeometryManager::GEOMETRY_NODE GeometryManager::AddGeometryToTree(const TDF_Labe
 			//geometryTree->AddChild(node, geom);
             //TopAbs_ShapeEnum shapeType = geom.GetShape()->Shape().ShapeType();
             //if (shapeType == TopAbs_SOLID || shapeType == TopAbs_FACE) {
-                return m_pGeometryTree->InsertItem(geom, node);
+                return newNode;
             //}
             //else {
             //    return node;
@@ -256,6 +339,611 @@ GeometryManager::GEOMETRY_NODE GeometryManager::AddGeometryToTree(const TDF_Labe
     return node;
 }
 
+void GeometryManager::MoveGeometry(GEOMETRY_NODE node, const gp_Trsf& delta)
+{
+    Geometry& geometry = node->GetData();
+    Handle(AIS_ColoredShape) shape = geometry.GetShape();
+    if (shape.IsNull()) {
+        // No object to carry the transformation (e.g. the root), move each child instead
+        for (GEOMETRY_NODE child = node->GetChild(); child; child = child->GetSibling()) {
+            MoveGeometry(child, delta);
+        }
+        return;
+    }
+
+    const gp_Trsf parentWorld = geometry.GetWorldTransform() * geometry.GetLocalLocation().Transformation().Inverted();
+    const gp_Trsf newLocal = delta * geometry.GetLocalLocation().Transformation();
+
+    // Collapse into single-datum locations so repeated moves don't grow the location chain
+    geometry.SetLocations(TopLoc_Location(parentWorld * newLocal), TopLoc_Location(newLocal));
+    if (geometry.GetInstanceIndex() >= 0) {
+        WriteInstanceMatrix(geometry.GetInstanceIndex(), geometry.GetWorldTransform());
+    }
+    m_BVH.UpdateItem(geometry.GetID(), geometry.GetWorldBox());
+    UpdateSubtreeWorldLocation(node->GetChild(), geometry.GetWorldLocation());
+
+    // Same rule as AddGeometryToTree(): an object without a parent object (its parent node has no shape) carries the world location
+    m_pDisplaySink->SetLocation(shape, shape->Parent() ? geometry.GetLocalLocation() : geometry.GetWorldLocation());
+    if (m_bMergedStatic) {
+        std::vector<int> movedIDs;
+        auto collect = [&movedIDs](GEOMETRY_NODE current, int depth) {
+            if (IsDisplayable(current->GetData())) movedIDs.push_back(current->GetData().GetID());
+        };
+        collect(node, 0);
+        m_pGeometryTree->ForEachNode(node->GetChild(), collect, 1);
+        UpdateMergedBatches(movedIDs);
+    }
+    m_pDisplaySink->Update();
+}
+
+void GeometryManager::UpdateSubtreeWorldLocation(GEOMETRY_NODE node, const TopLoc_Location& parentWorld)
+{
+    for (; node; node = node->GetSibling()) {
+        Geometry& geometry = node->GetData();
+        geometry.SetLocations(TopLoc_Location(parentWorld.Transformation() * geometry.GetLocalLocation().Transformation()),
+                              geometry.GetLocalLocation());
+        if (geometry.GetInstanceIndex() >= 0) {
+            WriteInstanceMatrix(geometry.GetInstanceIndex(), geometry.GetWorldTransform());
+        }
+        m_BVH.UpdateItem(geometry.GetID(), geometry.GetWorldBox());  // Refits only this leaf's path
+        UpdateSubtreeWorldLocation(node->GetChild(), geometry.GetWorldLocation());
+    }
+}
+
+bool GeometryManager::IsDisplayable(const Geometry& geometry)
+{
+    Handle(AIS_ColoredShape) shape = geometry.GetShape();
+    return !shape.IsNull() && shape->Shape().ShapeType() == TopAbs_SOLID;
+}
+
+void GeometryManager::BuildBoundingVolumeHierarchy()
+{
+    TRACE_SCOPE("GeometryManager::BuildBoundingVolumeHierarchy");
+    std::vector<GeometryBVH::Item> items;
+    m_pGeometryTree->ForEachNode(m_pGeometryTree->GetRoot(), [&items](GEOMETRY_NODE node, int depth) {
+        Geometry& geometry = node->GetData();
+        if (!IsDisplayable(geometry)) return;
+
+        if (geometry.GetLocalBox().IsVoid()) {
+            Bnd_Box localBox;
+            BRepBndLib::Add(geometry.GetShape()->Shape(), localBox);
+            geometry.SetLocalBox(localBox);
+        }
+        items.push_back({ geometry.GetID(), geometry.GetWorldBox() });
+    });
+    m_BVH.Build(std::move(items));
+}
+
+void GeometryManager::MeshAllGeometry()
+{
+    TRACE_SCOPE("GeometryManager::MeshAllGeometry");
+    m_pGeometryTree->ForEachNode(m_pGeometryTree->GetRoot(), [](GEOMETRY_NODE node, int depth) {
+        const Geometry& geometry = node->GetData();
+        if (IsDisplayable(geometry)) {
+            Handle(AIS_ColoredShape) shape = geometry.GetShape();
+            StdPrs_ToolTriangulatedShape::Tessellate(shape->Shape(), shape->Attributes());
+        }
+    });
+}
+
+size_t GeometryManager::GetGeometryCount() const
+{
+    size_t count = 0;
+    m_pGeometryTree->ForEachNode(m_pGeometryTree->GetRoot(), [&count](GEOMETRY_NODE node, int depth) {
+        if (!node->GetData().GetShape().IsNull()) ++count;
+    });
+    return count;
+}
+
+Bnd_Box GeometryManager::GetSelectionBounds() const
+{
+    std::vector<const AIS_InteractiveObject*> selected;
+    m_pDisplaySink->GetSelectedObjects(selected);
+
+    std::vector<int> geometryIDs;
+    for (const AIS_InteractiveObject* object : selected) {
+        auto it = m_ObjectGeometryIDs.find(object);
+        if (it != m_ObjectGeometryIDs.end()) geometryIDs.push_back(it->second);
+    }
+    m_pDisplaySink->GetSelectedPartIDs(geometryIDs);
+    return m_BVH.GetBounds(geometryIDs);
+}
+
+void GeometryManager::GetDisplayedGeometry(std::vector<DisplayedGeometry>& geometries) const
+{
+    for (const GeometryBVH::Item& item : m_BVH.GetItems()) {
+        if (!m_BVH.IsVisible(item.GeometryID)) continue;
+
+        auto it = m_NodesByID.find(item.GeometryID);
+        if (it != m_NodesByID.end()) geometries.push_back({ &it->second->GetData(), &item.Box });
+    }
+}
+
+void GeometryManager::CollectShapes(GEOMETRY_NODE node, std::vector<Handle(AIS_InteractiveObject)>& objects) const
+{
+    auto collect = [&objects](GEOMETRY_NODE current, int depth) {
+        const Geometry& geometry = current->GetData();
+        if (IsDisplayable(geometry)) objects.push_back(geometry.GetShape());
+    };
+    collect(node, 0);
+    m_pGeometryTree->ForEachNode(node->GetChild(), collect, 1);
+}
+
+void GeometryManager::SetGeometryVisible(GEOMETRY_NODE node, bool visible)
+{
+    std::vector<int> changedIDs;
+    auto apply = [this, visible, &changedIDs](GEOMETRY_NODE current, int depth) {
+        Geometry& geometry = current->GetData();
+        if (!IsDisplayable(geometry)) return;
+
+        if (visible) {
+            ShowGeometry(geometry);
+        }
+        else {
+            m_pDisplaySink->Erase(geometry.GetShape());
+            m_MemoryGovernor.OnHidden(geometry.GetID());
+        }
+        m_BVH.SetVisible(geometry.GetID(), visible);
+        changedIDs.push_back(geometry.GetID());
+    };
+    apply(node, 0);
+    m_pGeometryTree->ForEachNode(node->GetChild(), apply, 1);
+    if (m_bMergedStatic) UpdateMergedBatches(changedIDs);
+    EnforceMemoryBudget();
+    m_pDisplaySink->Update();
+}
+
+void GeometryManager::SetMergedStatic(bool enabled)
+{
+    if (enabled == m_bMergedStatic) return;
+
+    m_bMergedStatic = enabled;
+    if (enabled) {
+        BuildMergedBatches();
+    }
+    else {
+        ReleaseMergedBatches();
+    }
+
+    const bool measure = m_MemoryGovernor.GetBudget() != MemoryGovernor::s_Unlimited;
+    m_pGeometryTree->ForEachNode(m_pGeometryTree->GetRoot(), [this, enabled, measure](GEOMETRY_NODE node, int depth) {
+        const Geometry& geometry = node->GetData();
+        if (!IsDisplayable(geometry) || !m_BVH.IsVisible(geometry.GetID())) return;
+
+        // The batches hold a copy of the triangles, keeping the per-solid presentations as well would double the memory
+        if (enabled) {
+            m_pDisplaySink->ReleaseResources(geometry.GetShape());
+        }
+        else {
+            m_pDisplaySink->Display(geometry.GetShape());
+            if (m_SelectionMode != TopAbs_SOLID) {
+                m_pDisplaySink->SetSelectionMode(geometry.GetShape(), TopAbs_SOLID, m_SelectionMode);
+            }
+        }
+        if (measure) m_MemoryGovernor.SetBytes(geometry.GetID(), EstimateResidentBytes(geometry));
+    });
+    EnforceMemoryBudget();
+    m_pDisplaySink->Update();
+}
+
+void GeometryManager::SetPlanarWithoutNormals(bool enabled)
+{
+    if (enabled == m_bPlanarWithoutNormals) return;
+
+    m_bPlanarWithoutNormals = enabled;
+    if (m_bMergedStatic) {
+        BuildMergedBatches();
+        m_pDisplaySink->Update();
+    }
+}
+
+void GeometryManager::BuildMergedBatches()
+{
+    ReleaseMergedBatches();
+
+    std::unordered_set<int64_t> keys;
+    m_pGeometryTree->ForEachNode(m_pGeometryTree->GetRoot(), [this, &keys](GEOMETRY_NODE node, int depth) {
+        const Geometry& geometry = node->GetData();
+        if (!IsDisplayable(geometry) || !m_BVH.IsVisible(geometry.GetID())) return;
+
+        const int64_t key = GetMergedKey(geometry);
+        m_MergedKeys[geometry.GetID()] = key;
+        m_MergedParts[key].insert(geometry.GetID());
+        keys.insert(key);
+    });
+    RebuildMergedBatches(keys);
+}
+
+void GeometryManager::UpdateMergedBatches(const std::vector<int>& geometryIDs)
+{
+    std::unordered_set<int64_t> keys;
+    for (int geometryID : geometryIDs) {
+        auto it = m_MergedKeys.find(geometryID);
+        if (it != m_MergedKeys.end()) {
+            keys.insert(it->second);
+            m_MergedParts[it->second].erase(geometryID);
+            m_MergedKeys.erase(it);
+            m_MergedPartBytes.erase(geometryID);
+        }
+
+        const Geometry& geometry = m_NodesByID.at(geometryID)->GetData();
+        if (IsDisplayable(geometry) && m_BVH.IsVisible(geometryID)) {
+            const int64_t key = GetMergedKey(geometry);
+            m_MergedKeys[geometryID] = key;
+            m_MergedParts[key].insert(geometryID);
+            keys.insert(key);
+        }
+    }
+    RebuildMergedBatches(keys);
+}
+
+void GeometryManager::RebuildMergedBatches(const std::unordered_set<int64_t>& keys)
+{
+    TRACE_SCOPE("GeometryManager::RebuildMergedBatches");
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int64_t key : keys) {
+        auto batchIt = m_MergedBatches.find(key);
+        if (batchIt != m_MergedBatches.end()) {
+            for (const Handle(MergedBatch)& batch : batchIt->second) {
+                m_pDisplaySink->Erase(batch);
+                m_pDisplaySink->ReleaseResources(batch);
+            }
+            m_MergedBatches.erase(batchIt);
+        }
+
+        auto partIt = m_MergedParts.find(key);
+        if (partIt == m_MergedParts.end()) continue;
+        if (partIt->second.empty()) {
+            m_MergedParts.erase(partIt);
+            continue;
+        }
+
+        const MergedBatch::VertexFormat format = static_cast<MergedBatch::VertexFormat>(key & 3);
+        std::vector<Handle(MergedBatch)>& batches = m_MergedBatches[key];
+        for (int geometryID : partIt->second) {
+            const Geometry& geometry = m_NodesByID.at(geometryID)->GetData();
+            Handle(AIS_ColoredShape) shape = geometry.GetShape();
+            if (!StdPrs_ToolTriangulatedShape::IsTessellated(shape->Shape(), shape->Attributes())) {
+                StdPrs_ToolTriangulatedShape::Tessellate(shape->Shape(), shape->Attributes());
+            }
+            if (batches.empty() || !batches.back()->AddPart(geometryID, shape->Shape(), geometry.GetWorldTransform())) {
+                batches.push_back(new MergedBatch(geometry.GetColor(), format));  // First or full
+                batches.back()->AddPart(geometryID, shape->Shape(), geometry.GetWorldTransform());
+            }
+        }
+        for (const Handle(MergedBatch)& batch : batches) {
+            batch->Build();
+            m_pDisplaySink->Display(batch);
+
+            // Split the buffers between the parts by vertex count
+            const size_t batchBytes = batch->GetBufferBytes();
+            for (const MergedBatch::Part& part : batch->GetParts()) {
+                m_MergedPartBytes[part.GeometryID] = batchBytes * part.NbVertices / std::max<size_t>(batch->GetNbVertices(), 1);
+            }
+        }
+        if (m_MemoryGovernor.GetBudget() != MemoryGovernor::s_Unlimited) {
+            for (int geometryID : partIt->second) {
+                m_MemoryGovernor.SetBytes(geometryID, EstimateResidentBytes(m_NodesByID.at(geometryID)->GetData()));
+            }
+        }
+    }
+
+    m_MergedBatchStats = {};
+    for (const auto& keyBatches : m_MergedBatches) {
+        for (const Handle(MergedBatch)& batch : keyBatches.second) {
+            ++m_MergedBatchStats.BatchCount;
+            m_MergedBatchStats.VertexCount += batch->GetNbVertices();
+            m_MergedBatchStats.TriangleCount += batch->GetNbTriangles();
+            m_MergedBatchStats.BufferBytes += batch->GetBufferBytes();
+        }
+    }
+    m_MergedBatchStats.BuildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int64_t GeometryManager::GetMergedKey(const Geometry& geometry) const
+{
+    MergedBatch::VertexFormat format = MergedBatch::VertexFormat::Standard;
+    if (m_bPlanarWithoutNormals && MergedBatch::IsPlanar(geometry.GetShape()->Shape())) {
+        format = MergedBatch::VertexFormat::NoNormals;
+    }
+    Standard_Integer colorKey = 0;
+    Quantity_Color::Color2argb(geometry.GetColor(), colorKey);
+    return (static_cast<int64_t>(colorKey) << 2) | static_cast<int64_t>(format);
+}
+
+void GeometryManager::ReleaseMergedBatches()
+{
+    for (const auto& keyBatches : m_MergedBatches) {
+        for (const Handle(MergedBatch)& batch : keyBatches.second) {
+            m_pDisplaySink->Erase(batch);
+            m_pDisplaySink->ReleaseResources(batch);
+        }
+    }
+    m_MergedBatches.clear();
+    m_MergedParts.clear();
+    m_MergedKeys.clear();
+    m_MergedPartBytes.clear();
+    m_MergedBatchStats = {};
+}
+
+void GeometryManager::SetMemoryBudget(size_t bytes)
+{
+    const bool wasMeasuring = m_MemoryGovernor.GetBudget() != MemoryGovernor::s_Unlimited;
+    m_MemoryGovernor.SetBudget(bytes);
+    if (!wasMeasuring && bytes != MemoryGovernor::s_Unlimited) {
+        // Nothing was measured while unlimited
+        m_pGeometryTree->ForEachNode(m_pGeometryTree->GetRoot(), [this](GEOMETRY_NODE node, int depth) {
+            const Geometry& geometry = node->GetData();
+            if (IsDisplayable(geometry)) m_MemoryGovernor.SetBytes(geometry.GetID(), EstimateResidentBytes(geometry));
+        });
+    }
+    EnforceMemoryBudget();
+    m_pDisplaySink->Update();
+}
+
+void GeometryManager::ShowGeometry(Geometry& geometry)
+{
+    const int geometryID = geometry.GetID();
+    if (m_DehydratedIDs.count(geometryID) != 0 && !RehydrateGeometry(geometry)) {
+        Message::DefaultMessenger()->Send("Cannot rehydrate geometry from the part store", Message_Warning);
+    }
+    if (m_bMergedStatic) {
+        m_pDisplaySink->ReleaseResources(geometry.GetShape());  // Drawn by the next batch build, drop a presentation kept while hidden
+    }
+    else {
+        m_pDisplaySink->Display(geometry.GetShape());
+    }
+
+    if (!m_MemoryGovernor.IsResident(geometryID)) {
+        ++m_ResidentPartUsers[m_PartIDs.at(geometryID)];  // First display or rebuild after eviction
+    }
+    if (!m_bMergedStatic && m_MemoryGovernor.IsEvicted(geometryID) && m_SelectionMode != TopAbs_SOLID) {
+        // Removed objects come back with the default selection mode only, reactivate the current one
+        m_pDisplaySink->SetSelectionMode(geometry.GetShape(), TopAbs_SOLID, m_SelectionMode);
+    }
+    const bool measure = m_MemoryGovernor.GetBudget() != MemoryGovernor::s_Unlimited;
+    m_MemoryGovernor.OnShown(geometryID, measure ? EstimateResidentBytes(geometry) : 0);
+}
+
+size_t GeometryManager::EstimateResidentBytes(const Geometry& geometry) const
+{
+    Handle(AIS_ColoredShape) shape = geometry.GetShape();
+    MemoryFootprint footprint;
+    Footprint::VisitedSet visited;
+    Footprint::AddShape(shape->Shape(), visited, footprint);
+    // B-Rep and triangulation are shared by the instances of the part, each instance accounts for its share
+    const size_t instanceCount = m_PartInstanceCounts.at(m_PartIDs.at(geometry.GetID()));
+    size_t bytes = footprint.Triangulation / instanceCount;
+    if (m_PartStore.IsOpen()) bytes += footprint.BRep / instanceCount;  // Released on eviction as well
+    auto mergedIt = m_MergedPartBytes.find(geometry.GetID());
+    if (mergedIt != m_MergedPartBytes.end()) {
+        bytes += mergedIt->second;  // Its presentation and selection structures are released while merged
+    }
+    else {
+        bytes += m_pDisplaySink->EstimatePresentationBytes(shape) + Footprint::EstimateSelectionBytes(shape);
+    }
+    return bytes;
+}
+
+void GeometryManager::EnforceMemoryBudget()
+{
+    if (!m_MemoryGovernor.IsOverBudget()) return;
+
+    TRACE_SCOPE("GeometryManager::EnforceMemoryBudget");
+    std::vector<int> geometryIDs;
+    m_MemoryGovernor.CollectEvictions(geometryIDs);
+    for (int geometryID : geometryIDs) {
+        EvictGeometry(m_NodesByID.at(geometryID)->GetData());
+    }
+}
+
+namespace
+{
+    // Placeholder shape of a dehydrated geometry, still a solid for IsDisplayable()
+    TopoDS_Shape MakeEmptySolid()
+    {
+        TopoDS_Solid solid;
+        BRep_Builder().MakeSolid(solid);
+        return solid;
+    }
+}
+
+void GeometryManager::EvictGeometry(Geometry& geometry)
+{
+    Handle(AIS_ColoredShape) shape = geometry.GetShape();
+    const int partID = m_PartIDs.at(geometry.GetID());
+    if (m_PartStore.IsOpen() && !m_PartStore.Store(partID, shape->Shape())) return;  // Stays resident
+
+    m_pDisplaySink->ReleaseResources(shape);
+
+    // Shape data is shared by instances, keep it while one of them is still resident
+    auto it = m_ResidentPartUsers.find(partID);
+    const bool lastUser = it != m_ResidentPartUsers.end() && --it->second == 0;
+    if (lastUser) m_ResidentPartUsers.erase(it);
+
+    if (m_PartStore.IsOpen()) {
+        if (lastUser) m_ResidentParts.erase(partID);
+        geometry.ReleaseIndexedMap();
+        shape->SetShape(MakeEmptySolid());
+        m_DehydratedIDs.insert(geometry.GetID());
+    }
+    else if (lastUser) {
+        BRepTools::Clean(shape->Shape());  // Triangulation only, the B-Rep stays
+    }
+    m_MemoryGovernor.OnEvicted(geometry.GetID());
+}
+
+bool GeometryManager::EnablePartStore(const std::string& directory)
+{
+    if (m_PartStore.IsOpen()) return true;
+    if (!m_PartStore.Open(directory)) return false;
+
+    if (m_pGeometryTree->GetRoot()) ReleaseSourceShapes();
+    return true;
+}
+
+void GeometryManager::AssignPartIDs()
+{
+    // Instances share the solid, the first geometry referencing it names the part
+    std::unordered_map<const TopoDS_TShape*, int> partIDs;
+    m_pGeometryTree->ForEachNode(m_pGeometryTree->GetRoot(), [this, &partIDs](GEOMETRY_NODE node, int depth) {
+        const Geometry& geometry = node->GetData();
+        if (!IsDisplayable(geometry)) return;
+
+        auto result = partIDs.emplace(geometry.GetShape()->Shape().TShape().get(), geometry.GetID());
+        m_PartIDs[geometry.GetID()] = result.first->second;
+        ++m_PartInstanceCounts[result.first->second];
+    });
+}
+
+void GeometryManager::ReleaseSourceShapes()
+{
+    TRACE_SCOPE("GeometryManager::ReleaseSourceShapes");
+    m_hXCAFApp->Close(m_hStdDoc);
+    m_hXCAFApp->NewDocument("BinXCAF", m_hStdDoc);
+
+    TopoDS_Compound emptyCompound;
+    BRep_Builder().MakeCompound(emptyCompound);
+    m_pGeometryTree->ForEachNode(m_pGeometryTree->GetRoot(), [this, &emptyCompound](GEOMETRY_NODE node, int depth) {
+        const Geometry& geometry = node->GetData();
+        Handle(AIS_ColoredShape) shape = geometry.GetShape();
+        if (shape.IsNull()) return;
+
+        if (!IsDisplayable(geometry)) {
+            shape->SetShape(emptyCompound);  // Never displayed, the object only carries the assembly placement
+        }
+        else if (!m_MemoryGovernor.IsEvicted(geometry.GetID())) {
+            m_ResidentParts.emplace(m_PartIDs.at(geometry.GetID()), shape->Shape());
+        }
+    });
+}
+
+bool GeometryManager::RehydrateGeometry(Geometry& geometry)
+{
+    const int partID = m_PartIDs.at(geometry.GetID());
+    auto it = m_ResidentParts.find(partID);
+    if (it == m_ResidentParts.end()) {
+        TopoDS_Shape part = m_PartStore.Load(partID);  // Triangulation included, no remeshing
+        if (part.IsNull()) return false;
+        it = m_ResidentParts.emplace(partID, part).first;
+    }
+    geometry.GetShape()->SetShape(it->second);
+    geometry.CreateIndexedMap();
+    m_DehydratedIDs.erase(geometry.GetID());
+    return true;
+}
+
+void GeometryManager::GetMemoryReport(std::vector<GeometryMemoryInfo>& report) const
+{
+    TRACE_SCOPE("GeometryManager::GetMemoryReport");
+    report.clear();
+    Footprint::VisitedSet visited;
+    for (GEOMETRY_NODE node = m_pGeometryTree->GetRoot(); node; node = node->GetSibling()) {
+        AppendMemoryInfo(node, 0, visited, report);
+    }
+}
+
+void GeometryManager::AppendMemoryInfo(GEOMETRY_NODE node, int depth, Footprint::VisitedSet& visited, std::vector<GeometryMemoryInfo>& report) const
+{
+    const Geometry& geometry = node->GetData();
+    const size_t index = report.size();
+    report.push_back({ geometry.GetID(), depth, 0, geometry.GetName(), MemoryFootprint(), MemoryFootprint() });
+
+    // Children first, so data an assembly compound shares with its parts is charged to the parts
+    for (GEOMETRY_NODE child = node->GetChild(); child; child = child->GetSibling()) {
+        AppendMemoryInfo(child, depth + 1, visited, report);
+    }
+
+    MemoryFootprint own;
+    Handle(AIS_ColoredShape) shape = geometry.GetShape();
+    if (!shape.IsNull()) {
+        Footprint::AddShape(shape->Shape(), visited, own);
+        own.Presentation = m_pDisplaySink->EstimatePresentationBytes(shape);
+        own.Selection = Footprint::EstimateSelectionBytes(shape);
+    }
+    for (const TopTools_IndexedMapOfShape* pMap : { geometry.GetVertexMap(), geometry.GetEdgeMap(), geometry.GetFaceMap() }) {
+        if (pMap) own.IndexMap += Footprint::EstimateIndexMapBytes(*pMap);
+    }
+
+    MemoryFootprint subtree = own;
+    for (size_t i = index + 1; i < report.size(); i = report[i].SubtreeEnd) {  // Direct children only
+        subtree += report[i].Subtree;
+    }
+
+    GeometryMemoryInfo& info = report[index];
+    info.Own = own;
+    info.Subtree = subtree;
+    info.SubtreeEnd = report.size();
+}
+
+namespace
+{
+    void WriteFootprintJson(std::ostream& os, const MemoryFootprint& footprint)
+    {
+        os << "{\"brep\":" << footprint.BRep
+           << ",\"triangulation\":" << footprint.Triangulation
+           << ",\"presentation\":" << footprint.Presentation
+           << ",\"selection\":" << footprint.Selection
+           << ",\"index_map\":" << footprint.IndexMap
+           << ",\"total\":" << footprint.Total() << "}";
+    }
+
+    void WriteMemoryInfoJson(std::ostream& os, const std::vector<GeometryMemoryInfo>& report, size_t index)
+    {
+        const GeometryMemoryInfo& info = report[index];
+        os << "{\"id\":" << info.GeometryID << ",\"name\":\"";
+        for (char c : info.Name) {
+            if (c == '"' || c == '\\') os << '\\';
+            if (static_cast<unsigned char>(c) >= 0x20) os << c;
+        }
+        os << "\",\"own\":";
+        WriteFootprintJson(os, info.Own);
+        os << ",\"subtree\":";
+        WriteFootprintJson(os, info.Subtree);
+        os << ",\"children\":[";
+        for (size_t i = index + 1; i < info.SubtreeEnd; i = report[i].SubtreeEnd) {
+            if (i != index + 1) os << ",";
+            WriteMemoryInfoJson(os, report, i);
+        }
+        os << "]}";
+    }
+}
+
+void GeometryManager::WriteMemoryReportJson(std::ostream& os) const
+{
+    std::vector<GeometryMemoryInfo> report;
+    GetMemoryReport(report);
+
+    os << "{\"geometries\":[";
+    for (size_t i = 0; i < report.size(); i = report[i].SubtreeEnd) {
+        if (i != 0) os << ",";
+        WriteMemoryInfoJson(os, report, i);
+    }
+    os << "]}\n";
+}
+
+int GeometryManager::AddInstanceMatrix(const Geometry& geometry)
+{
+    const int index = static_cast<int>(m_InstanceGeometryIDs.size());
+    m_InstanceGeometryIDs.push_back(geometry.GetID());
+    m_InstanceMatrices.resize(m_InstanceMatrices.size() + 16);
+    WriteInstanceMatrix(index, geometry.GetWorldTransform());
+    return index;
+}
+
+void GeometryManager::WriteInstanceMatrix(int index, const gp_Trsf& trsf)
+{
+    // Column-major 4x4, the layout expected by WebGL and most JS math libraries
+    float* matrix = m_InstanceMatrices.data() + static_cast<size_t>(index) * 16;
+    for (int col = 1; col <= 4; ++col) {
+        for (int row = 1; row <= 3; ++row) {
+            *matrix++ = static_cast<float>(trsf.Value(row, col));
+        }
+        *matrix++ = col == 4 ? 1.0f : 0.0f;
+    }
+}
+
 TCollection_AsciiString GeometryManager::GetEntryString(const TDF_Label& label)
 {
     TCollection_AsciiString entryStr;
@@ -280,7 +968,8 @@ void GeometryManager::PrintIDName(GEOMETRY_NODE node, int depth) {
 
     TCollection_AsciiString lbr("["), rbr("]");
     TCollection_AsciiString id(node->GetData().GetID());
-    TCollection_AsciiString name(node->GetData().GetName().c_str());
+    std::string_view nameView = node->GetData().GetName();
+    TCollection_AsciiString name(nameView.data(), static_cast<int>(nameView.size()));
     TCollection_AsciiString shType;
 
     if (node->GetData().HasShape())
@@ -360,22 +1049,34 @@ void GeometryManager::PrintAllGeometryName()
     //m_pGeometryTree->LoopTree(m_pGeometryTree->GetRoot(), GeometryManager::PrintGeometryIndexMap);
 }
 
-void GeometryManager::DisplayGeometry(GEOMETRY_NODE node, int depth)
+GeometryManager::GEOMETRY_NODE GeometryManager::FindGeometryByName(std::string_view name) const
 {
-    Handle(AIS_ColoredShape) shape = node->GetData().GetShape();
-    WasmOcctView& viewer = WasmOcctView::Instance();
-
-    if (!shape.IsNull()) {
-        const TopoDS_Shape aShape = shape->Shape();
-        if (aShape.ShapeType() == TopAbs_SOLID/* || aShape.ShapeType() == TopAbs_SHELL || aShape.ShapeType() == TopAbs_WIRE*/) {
-            viewer.Context()->Display(shape, false);
-        }
+    if (!m_pGeometryTree->GetRoot()) return nullptr;
+
+    // Names are compared by interned ID when possible. Generated names are interned lazily (Geometry::GetNameID()),
+    // so a miss in the table does not mean the name is unknown: compare the strings then, interning them on the way.
+    StringTable::StringID nameID = StringTable::GetInstance().Find(name);
+    if (nameID == StringTable::InvalidID) {
+        return m_pGeometryTree->FindNode(m_pGeometryTree->GetRoot(), [name](GEOMETRY_NODE node) {
+            return node->GetData().GetName() == name;
+        });
     }
+
+    return m_pGeometryTree->FindNode(m_pGeometryTree->GetRoot(), [nameID](GEOMETRY_NODE node) {
+        return node->GetData().GetNameID() == nameID;
+    });
 }
 
 void GeometryManager::DisplayAllGeometry()  // Currently display solid only
 {
-    m_pGeometryTree->LoopTree(m_pGeometryTree->GetRoot(), GeometryManager::DisplayGeometry);
+    TRACE_SCOPE("GeometryManager::DisplayAllGeometry");
+    m_pGeometryTree->ForEachNode(m_pGeometryTree->GetRoot(), [this](GEOMETRY_NODE node, int depth) {
+        Geometry& geometry = node->GetData();
+        if (IsDisplayable(geometry)) {
+            ShowGeometry(geometry);
+        }
+    });
+    if (m_bMergedStatic) BuildMergedBatches();
 }
 
 void GeometryManager::CreateGeometryIndexMap(GEOMETRY_NODE node, int depth)
@@ -394,105 +1095,45 @@ void GeometryManager::CreateGeometryIndexMap(GEOMETRY_NODE node, int depth)
 
 void GeometryManager::CreateAllGeometryIndexMap()
 {
+    TRACE_SCOPE("GeometryManager::CreateAllGeometryIndexMap");
     m_pGeometryTree->LoopTree(m_pGeometryTree->GetRoot(), GeometryManager::CreateGeometryIndexMap);
 }
 
-void GeometryManager::SelectVertex(GEOMETRY_NODE node, int depth)
+void GeometryManager::SetSelectionMode(TopAbs_ShapeEnum mode)
 {
-    Handle(AIS_ColoredShape) shape = node->GetData().GetShape();
-    WasmOcctView& viewer = WasmOcctView::Instance();
-
-    if (!shape.IsNull()) {
-        const TopoDS_Shape aShape = shape->Shape();
-        if (aShape.ShapeType() == TopAbs_SOLID/* || aShape.ShapeType() == TopAbs_SHELL || aShape.ShapeType() == TopAbs_WIRE*/) {
-            viewer.Context()->Deactivate(shape, AIS_Shape::SelectionMode(viewer.GetSelectionMode()));
-            viewer.Context()->Activate(shape, AIS_Shape::SelectionMode(TopAbs_VERTEX));
+    m_pGeometryTree->ForEachNode(m_pGeometryTree->GetRoot(), [this, mode](GEOMETRY_NODE node, int depth) {
+        const Geometry& geometry = node->GetData();
+        if (IsDisplayable(geometry)) {
+            m_pDisplaySink->SetSelectionMode(geometry.GetShape(), m_SelectionMode, mode);
         }
-    }
+    });
+    m_SelectionMode = mode;
 }
 
 void GeometryManager::SelectVertexMode()
 {
-    m_pGeometryTree->LoopTree(m_pGeometryTree->GetRoot(), GeometryManager::SelectVertex);
-
-    WasmOcctView& viewer = WasmOcctView::Instance();
-    viewer.SetSelectionMode(TopAbs_VERTEX);
+    SetSelectionMode(TopAbs_VERTEX);
 
     Message::DefaultMessenger()->Send(TCollection_AsciiString("VertexMode"), Message_Info);
 }
 
-void GeometryManager::SelectEdge(GEOMETRY_NODE node, int depth)
-{
-    Handle(AIS_ColoredShape) shape = node->GetData().GetShape();
-    WasmOcctView& viewer = WasmOcctView::Instance();
-
-    if (!shape.IsNull()) {
-        const TopoDS_Shape aShape = shape->Shape();
-        if (aShape.ShapeType() == TopAbs_SOLID) {
-            viewer.Context()->Deactivate(shape, AIS_Shape::SelectionMode(viewer.GetSelectionMode()));
-            viewer.Context()->Activate(shape, AIS_Shape::SelectionMode(TopAbs_EDGE));
-        }
-    }
-}
-
 void GeometryManager::SelectEdgeMode()
 {
-    m_pGeometryTree->LoopTree(m_pGeometryTree->GetRoot(), GeometryManager::SelectEdge);
-
-    WasmOcctView& viewer = WasmOcctView::Instance();
-    viewer.SetSelectionMode(TopAbs_EDGE);
+    SetSelectionMode(TopAbs_EDGE);
 
     Message::DefaultMessenger()->Send(TCollection_AsciiString("EdgeMode"), Message_Info);
 }
 
-void GeometryManager::SelectFace(GEOMETRY_NODE node, int depth)
-{
-    Handle(AIS_ColoredShape) shape = node->GetData().GetShape();
-    WasmOcctView& viewer = WasmOcctView::Instance();
-
-    if (!shape.IsNull()) {
-        const TopoDS_Shape aShape = shape->Shape();
-        if (aShape.ShapeType() == TopAbs_SOLID) {
-            viewer.Context()->Deactivate(shape, AIS_Shape::SelectionMode(viewer.GetSelectionMode()));
-            viewer.Context()->Activate(shape, AIS_Shape::SelectionMode(TopAbs_FACE));
-        }
-    }
-}
-
 void GeometryManager::SelectFaceMode()
 {
-    m_pGeometryTree->LoopTree(m_pGeometryTree->GetRoot(), GeometryManager::SelectFace);
-
-    WasmOcctView& viewer = WasmOcctView::Instance();
-    //viewer.Context()->Deactivate();
-    //viewer.Context()->Activate(AIS_Shape::SelectionMode(TopAbs_FACE));
-    viewer.SetSelectionMode(TopAbs_FACE);
+    SetSelectionMode(TopAbs_FACE);
 
     Message::DefaultMessenger()->Send(TCollection_AsciiString("FaceMode"), Message_Info);
 }
 
-void GeometryManager::SelectSolid(GEOMETRY_NODE node, int depth)
-{
-    Handle(AIS_ColoredShape) shape = node->GetData().GetShape();
-    WasmOcctView& viewer = WasmOcctView::Instance();
-
-    if (!shape.IsNull()) {
-        const TopoDS_Shape aShape = shape->Shape();
-        if (aShape.ShapeType() == TopAbs_SOLID) {
-            viewer.Context()->Deactivate(shape, AIS_Shape::SelectionMode(viewer.GetSelectionMode()));
-            viewer.Context()->Activate(shape, AIS_Shape::SelectionMode(TopAbs_SOLID));
-        }
-    }
-}
-
 void GeometryManager::SelectSolidMode()
 {
-    m_pGeometryTree->LoopTree(m_pGeometryTree->GetRoot(), GeometryManager::SelectSolid);
-
-    WasmOcctView& viewer = WasmOcctView::Instance();
-    //viewer.Context()->Deactivate();
-    //viewer.Context()->Activate(AIS_Shape::SelectionMode(TopAbs_SOLID));
-    viewer.SetSelectionMode(TopAbs_SOLID);
+    SetSelectionMode(TopAbs_SOLID);
 
     Message::DefaultMessenger()->Send(TCollection_AsciiString("SolidMode"), Message_Info);
-}
\ No newline at end of file
+}
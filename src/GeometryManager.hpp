@@ -3,11 +3,58 @@
 #include <XCAFApp_Application.hxx>
 #include <TDocStd_Document.hxx>
 #include <TopLoc_Location.hxx>
+#include <Bnd_Box.hxx>
+#include <TopAbs_ShapeEnum.hxx>
+
+#include "GeometryBVH.hpp"
+#include "MemoryFootprint.hpp"
+#include "MemoryGovernor.hpp"
+#include "PartStore.hpp"
+
+#include <cstdint>
+#include <ostream>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 template <typename T> class LCRSTree; 
 template <typename T> class LCRSNode;
 class Geometry;
 class TDF_Label;
+class gp_Trsf;
+class AIS_InteractiveObject;
+class DisplaySink;
+class MergedBatch;
+
+struct GeometryMemoryInfo
+{
+    int GeometryID;
+    int Depth;
+    size_t SubtreeEnd;  // Index after the last descendant in the report
+    std::string_view Name;
+    MemoryFootprint Own;
+    MemoryFootprint Subtree;
+};
+
+// A displayed geometry and its world box, for view-dependent display policies
+struct DisplayedGeometry
+{
+    const Geometry* pGeometry;
+    const Bnd_Box* pWorldBox;  // Owned by the BVH
+};
+
+// Merged batches currently displayed, see GeometryManager::SetMergedStatic()
+struct MergedBatchStats
+{
+    size_t BatchCount;
+    size_t VertexCount;
+    size_t TriangleCount;
+    size_t BufferBytes;  // Vertex and index buffers to upload
+    double BuildMs;      // Last build, upload excluded (it happens with the next redraw)
+};
 
 class GeometryManager
 {
@@ -15,29 +62,149 @@ class GeometryManager
     using GEOMETRY_TREE = LCRSTree<Geometry>*;
 
 public:
-    GeometryManager();
+    // The sink is not owned and must outlive the manager
+    explicit GeometryManager(DisplaySink* pDisplaySink);
     ~GeometryManager();
 
+    void SetDisplaySink(DisplaySink* pDisplaySink) { m_pDisplaySink = pDisplaySink; }
+
     bool ImportStepFile(const char* fileName, std::istream& istream);
+    bool ImportBRepFile(const char* fileName, std::istream& istream);
+
+    // Individual import phases, the Import*File() methods run a read followed by LoadGeometryFromOCCDoc()
+    bool GetOCCDocFromStepFile(const char* fileName, std::istream& istream);
+    bool GetOCCDocFromBRepFile(const char* fileName, std::istream& istream);
+    bool LoadGeometryFromOCCDoc();
+
+    // Triangulates displayable shapes up front with their presentation deflection (display does it on demand otherwise)
+    void MeshAllGeometry();
+    size_t GetGeometryCount() const;  // Nodes carrying a shape
+
     void PrintAllGeometryName();
     void DisplayAllGeometry();
     void CreateAllGeometryIndexMap();
+    void BuildBoundingVolumeHierarchy();  // After display, so boxes can use the triangulation
+
+    // Returns nullptr if no geometry has this name
+    GEOMETRY_NODE FindGeometryByName(std::string_view name) const;
+
+    // Applies delta (expressed in the parent frame) to the local placement of node.
+    // The whole subtree follows through a single transformation update of the node's object.
+    void MoveGeometry(GEOMETRY_NODE node, const gp_Trsf& delta);
+
+    // Spatial queries answered by the geometry BVH
+    Bnd_Box GetSceneBounds() const { return m_BVH.GetBounds(); }  // Visible geometry only
+    Bnd_Box GetSelectionBounds() const;
+    void QueryRegion(const Bnd_Box& region, std::vector<int>& geometryIDs) const { m_BVH.Query(region, geometryIDs); }
+    const GeometryBVH& GetBVH() const { return m_BVH; }
+    // Visible geometry of the BVH, pointers stay valid until the next import
+    void GetDisplayedGeometry(std::vector<DisplayedGeometry>& geometries) const;
+    // Displayable objects of node and its subtree
+    void CollectShapes(GEOMETRY_NODE node, std::vector<Handle(AIS_InteractiveObject)>& objects) const;
+
+    void SetGeometryVisible(GEOMETRY_NODE node, bool visible);
+
+    // Memory held by every geometry node, in depth-first order.
+    // Data shared between nodes (instances, assembly compounds) is charged once, to the first leaf referencing it.
+    void GetMemoryReport(std::vector<GeometryMemoryInfo>& report) const;
+    void WriteMemoryReportJson(std::ostream& os) const;
+
+    // Rendering resources of erased geometry are released, least recently erased first, while the resident
+    // estimate exceeds the budget. Resources are only measured while a budget is set (MemoryGovernor::s_Unlimited).
+    void SetMemoryBudget(size_t bytes);
+    const MemoryGovernor::Stats& GetMemoryGovernorStats() const { return m_MemoryGovernor.GetStats(); }
+
+    // Evicted geometry also gives up its B-Rep and triangulation, which are written to blobs in directory and read
+    // back when the geometry is displayed again. Only tree metadata and bounding boxes stay resident for evicted parts,
+    // so the source document is dropped after loading.
+    bool EnablePartStore(const std::string& directory);
+    const PartStore::Stats& GetPartStoreStats() const { return m_PartStore.GetStats(); }
+
+    // Draws visible solids as per-color MergedBatch objects (one draw call each) instead of one object per solid.
+    // Moving, showing or hiding geometry rebuilds only the batches of its color. Picking resolves to whole parts only,
+    // the vertex/edge/face selection modes do not apply to batches. The per-solid presentations are released while
+    // merged, the memory governor accounts each part with its share of the batch buffers.
+    void SetMergedStatic(bool enabled);
+    bool IsMergedStatic() const { return m_bMergedStatic; }
+    size_t GetMergedBatchCount() const { return m_MergedBatchStats.BatchCount; }
+
+    // Merged batches without normals for parts made of planar faces, half the vertex bytes
+    void SetPlanarWithoutNormals(bool enabled);
+    bool IsPlanarWithoutNormals() const { return m_bPlanarWithoutNormals; }
+    const MergedBatchStats& GetMergedBatchStats() const { return m_MergedBatchStats; }
+
+    // World transforms of all placed instances, 16 floats (column-major 4x4) per instance.
+    // Instance i belongs to the geometry whose ID is GetInstanceGeometryIDs()[i].
+    const std::vector<float>& GetInstanceMatrices() const { return m_InstanceMatrices; }
+    const std::vector<int>& GetInstanceGeometryIDs() const { return m_InstanceGeometryIDs; }
 
     void SelectVertexMode();
     void SelectEdgeMode();
     void SelectFaceMode();
     void SelectSolidMode();
+    TopAbs_ShapeEnum GetSelectionMode() const { return m_SelectionMode; }
 
 private:
     GEOMETRY_TREE m_pGeometryTree;
+    DisplaySink* m_pDisplaySink;
+    TopAbs_ShapeEnum m_SelectionMode;
 
     Handle(XCAFApp_Application) m_hXCAFApp;
     Handle(TDocStd_Document) m_hStdDoc;
 
-    bool GetOCCDocFromStepFile(const char* fileName, std::istream& istream);
-    bool LoadGeometryFromOCCDoc();
-    void IterateFather(const TDF_Label& label, GEOMETRY_NODE node, const int tag, TopLoc_Location loc, bool callByTree = false);
-    GEOMETRY_NODE AddGeometryToTree(const TDF_Label& label, GEOMETRY_NODE node, const int tag, TopLoc_Location loc);
+    std::vector<float> m_InstanceMatrices;
+    std::vector<int> m_InstanceGeometryIDs;
+
+    GeometryBVH m_BVH;
+    std::unordered_map<const AIS_InteractiveObject*, int> m_ObjectGeometryIDs;
+    std::unordered_map<int, GEOMETRY_NODE> m_NodesByID;
+
+    MemoryGovernor m_MemoryGovernor;
+    std::unordered_map<int, int> m_PartIDs;            // Geometry ID -> part ID, the first geometry sharing its solid
+    std::unordered_map<int, int> m_ResidentPartUsers;  // Resident geometries per part, for instances
+    std::unordered_map<int, int> m_PartInstanceCounts; // Geometries per part
+
+    PartStore m_PartStore;
+    std::unordered_map<int, TopoDS_Shape> m_ResidentParts;  // With a part store: parts in memory, by part ID
+    std::unordered_set<int> m_DehydratedIDs;                 // Geometries whose shape is only in the part store
+
+    bool m_bMergedStatic { false };
+    bool m_bPlanarWithoutNormals { false };
+    std::unordered_map<int64_t, std::vector<Handle(MergedBatch)>> m_MergedBatches;  // By batch key (color and vertex format)
+    std::unordered_map<int64_t, std::set<int>> m_MergedParts;                       // Geometry IDs by batch key
+    std::unordered_map<int, int64_t> m_MergedKeys;                                  // Batch key by geometry ID
+    std::unordered_map<int, size_t> m_MergedPartBytes;                              // Share of the batch buffers by geometry ID
+    MergedBatchStats m_MergedBatchStats {};
+
+    void IterateFather(const TDF_Label& label, GEOMETRY_NODE node, const int tag, const TopLoc_Location& loc, bool callByTree = false);
+    GEOMETRY_NODE AddGeometryToTree(const TDF_Label& label, GEOMETRY_NODE node, const int tag, const TopLoc_Location& loc);
+
+    // Appends the world transform of a placed instance and returns its instance index
+    int AddInstanceMatrix(const Geometry& geometry);
+    void WriteInstanceMatrix(int index, const gp_Trsf& trsf);
+    void UpdateSubtreeWorldLocation(GEOMETRY_NODE node, const TopLoc_Location& parentWorld);
+    void AppendMemoryInfo(GEOMETRY_NODE node, int depth, Footprint::VisitedSet& visited, std::vector<GeometryMemoryInfo>& report) const;
+
+    static bool IsDisplayable(const Geometry& geometry);  // Currently solids only
+    void SetSelectionMode(TopAbs_ShapeEnum mode);
+
+    // Memory governor bookkeeping around Display()/Erase()
+    void ShowGeometry(Geometry& geometry);  // Rehydrates from the part store first if needed
+    size_t EstimateResidentBytes(const Geometry& geometry) const;
+    void EnforceMemoryBudget();
+    void EvictGeometry(Geometry& geometry);
+
+    void BuildMergedBatches();  // Replaces the current batches
+    // Moves geometries to the batches matching their current state, rebuilding only the batches they leave or join
+    void UpdateMergedBatches(const std::vector<int>& geometryIDs);
+    void RebuildMergedBatches(const std::unordered_set<int64_t>& keys);
+    int64_t GetMergedKey(const Geometry& geometry) const;
+    void ReleaseMergedBatches();
+
+    void AssignPartIDs();
+    // With a part store, drops the document and assembly compounds, which keep every part referenced
+    void ReleaseSourceShapes();
+    bool RehydrateGeometry(Geometry& geometry);
 
     // Getters
     TCollection_AsciiString GetEntryString(const TDF_Label& label);
@@ -46,11 +213,5 @@ private:
     // For Looping Geometry Tree
     static void PrintIDName(GEOMETRY_NODE node, int depth);
     static void PrintGeometryIndexMap(GEOMETRY_NODE node, int depth);
-    static void DisplayGeometry(GEOMETRY_NODE node, int depth);
     static void CreateGeometryIndexMap(GEOMETRY_NODE node, int depth);
-
-    static void SelectVertex(GEOMETRY_NODE node, int depth);
-    static void SelectEdge(GEOMETRY_NODE node, int depth);
-    static void SelectFace(GEOMETRY_NODE node, int depth);
-    static void SelectSolid(GEOMETRY_NODE node, int depth);
 };
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "AppManager.hpp"
+#include "DisplaySink.hpp"
+#include "Trace.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+
+// Native entry point: runs the same import pipeline as the web viewer without a window or GL context.
+// Usage: Occt-Wasm-ImGui-headless [--trace trace.json] [--memory memory.json] <file.step|file.brep> [...]
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " [--trace trace.json] [--memory memory.json] <file.step|file.brep> [...]" << std::endl;
+        return 1;
+    }
+
+    RecordingDisplaySink* pSink = new RecordingDisplaySink();
+    AppManager& app = AppManager::GetInstance();
+    app.SetDisplaySink(pSink);
+
+    std::string tracePath;
+    std::string memoryPath;
+    for (int i = 1; i < argc; ++i) {
+        const std::string fileName(argv[i]);
+        if (fileName == "--trace" && i + 1 < argc) {
+            tracePath = argv[++i];
+            continue;
+        }
+        if (fileName == "--memory" && i + 1 < argc) {
+            memoryPath = argv[++i];
+            continue;
+        }
+
+        std::ifstream file(fileName, std::ios::binary);
+        if (!file) {
+            std::cerr << "Unable to open " << fileName << std::endl;
+            return 1;
+        }
+
+        const size_t dot = fileName.find_last_of('.');
+        const std::string ext = dot == std::string::npos ? std::string() : fileName.substr(dot + 1);
+        const GeomFileType fileType = (ext == "brep" || ext == "BREP") ? GeomFileType::BREP : GeomFileType::STEP;
+
+        pSink->Reset();
+        app.ImportGeometry(fileName.c_str(), file, fileType);
+
+        std::cout << fileName << ": " << pSink->GetDisplayedCount() << " displayed objects, "
+                  << app.GetInstanceGeometryIDs().size() << " instances" << std::endl;
+    }
+
+    if (!memoryPath.empty()) {
+        std::ofstream memoryFile(memoryPath);
+        app.WriteMemoryReportJson(memoryFile);
+    }
+    if (!tracePath.empty() && !Trace::WriteChromeJson(tracePath.c_str())) {
+        std::cerr << "Unable to write " << tracePath << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "InputRecorder.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+
+namespace
+{
+    double NowMs()
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+void InputRecorder::Start(const Graphic3d_Vec2i& canvasSize)
+{
+    m_Records.clear();
+    m_CanvasSize = canvasSize;
+    m_StartMs = NowMs();
+    m_bRecording = true;
+}
+
+InputRecord& InputRecorder::Append(InputRecord::Kind kind)
+{
+    InputRecord record {};
+    record.TimeUs = static_cast<uint32_t>((NowMs() - m_StartMs) * 1000.0);
+    record.EventKind = kind;
+    m_Records.push_back(record);
+    return m_Records.back();
+}
+
+void InputRecorder::RecordMouse(InputRecord::Kind kind, const Graphic3d_Vec2i& point, Aspect_VKeyMouse buttons, Aspect_VKeyFlags flags)
+{
+    if (!m_bRecording) return;
+
+    InputRecord& record = Append(kind);
+    record.Buttons = static_cast<uint16_t>(buttons);
+    record.Flags = static_cast<uint16_t>(flags);
+    record.X = static_cast<float>(point.x());
+    record.Y = static_cast<float>(point.y());
+}
+
+void InputRecorder::RecordWheel(const Aspect_ScrollDelta& delta)
+{
+    if (!m_bRecording) return;
+
+    InputRecord& record = Append(InputRecord::Kind::Wheel);
+    record.Flags = static_cast<uint16_t>(delta.Flags);
+    record.X = static_cast<float>(delta.Point.x());
+    record.Y = static_cast<float>(delta.Point.y());
+    record.Delta = static_cast<float>(delta.Delta);
+}
+
+void InputRecorder::RecordTouch(InputRecord::Kind kind, Standard_Size touchID, const Graphic3d_Vec2d& point)
+{
+    if (!m_bRecording) return;
+
+    InputRecord& record = Append(kind);
+    record.Code = static_cast<uint16_t>(touchID);
+    record.X = static_cast<float>(point.x());
+    record.Y = static_cast<float>(point.y());
+}
+
+void InputRecorder::RecordKey(InputRecord::Kind kind, Aspect_VKey key)
+{
+    if (!m_bRecording) return;
+
+    Append(kind).Code = static_cast<uint16_t>(key);
+}
+
+void InputRecorder::RecordFrame()
+{
+    // Consecutive boundaries without events carry no information
+    if (!m_bRecording || m_Records.empty() || m_Records.back().EventKind == InputRecord::Kind::Frame) return;
+
+    Append(InputRecord::Kind::Frame);
+}
+
+bool InputRecorder::Save(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    InputLogHeader header {};
+    std::memcpy(header.Magic, "OWIL", 4);
+    header.Version = s_Version;
+    header.RecordCount = static_cast<uint32_t>(m_Records.size());
+    header.CanvasWidth = m_CanvasSize.x();
+    header.CanvasHeight = m_CanvasSize.y();
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(m_Records.data()), m_Records.size() * sizeof(InputRecord));
+    return static_cast<bool>(file);
+}
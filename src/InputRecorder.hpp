@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Aspect_ScrollDelta.hxx>
+#include <Aspect_VKey.hxx>
+#include <Graphic3d_Vec2.hxx>
+#include <Standard_TypeDef.hxx>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+// One input event as it reached the view controller, in canvas backing pixels
+struct InputRecord
+{
+    enum class Kind : uint8_t
+    {
+        MouseMove,
+        MouseButtons,
+        Wheel,
+        TouchAdd,
+        TouchUpdate,
+        TouchRemove,
+        KeyDown,
+        KeyUp,
+        Frame  // Frame boundary, the events before it were flushed together
+    };
+
+    uint32_t TimeUs;   // Since the start of the recording
+    Kind EventKind;
+    uint8_t Reserved;
+    uint16_t Code;     // Aspect_VKey of key events, touch identifier
+    uint16_t Buttons;  // Aspect_VKeyMouse
+    uint16_t Flags;    // Aspect_VKeyFlags
+    float X;
+    float Y;
+    float Delta;       // Wheel steps
+};
+
+static_assert(sizeof(InputRecord) == 24, "InputRecord is the on-disk record layout");
+
+// Header of an input log file, followed by RecordCount records
+struct InputLogHeader
+{
+    char Magic[4];  // "OWIL"
+    uint32_t Version;
+    uint32_t RecordCount;
+    int32_t CanvasWidth;  // Positions only replay faithfully on a canvas of the same size
+    int32_t CanvasHeight;
+};
+
+// Captures the input stream reaching the view controller into memory, Save() writes it as a compact binary log.
+// UI events captured by ImGui never reach the controller and are not recorded.
+class InputRecorder
+{
+public:
+    static constexpr uint32_t s_Version = 1;
+
+    void Start(const Graphic3d_Vec2i& canvasSize);
+    void Stop() { m_bRecording = false; }
+    bool IsRecording() const { return m_bRecording; }
+
+    void RecordMouse(InputRecord::Kind kind, const Graphic3d_Vec2i& point, Aspect_VKeyMouse buttons, Aspect_VKeyFlags flags);
+    void RecordWheel(const Aspect_ScrollDelta& delta);
+    void RecordTouch(InputRecord::Kind kind, Standard_Size touchID, const Graphic3d_Vec2d& point);
+    void RecordKey(InputRecord::Kind kind, Aspect_VKey key);
+    void RecordFrame();
+
+    bool Save(const std::string& path) const;
+    size_t GetRecordCount() const { return m_Records.size(); }
+
+private:
+    std::vector<InputRecord> m_Records;
+    Graphic3d_Vec2i m_CanvasSize;
+    double m_StartMs { 0.0 };
+    bool m_bRecording { false };
+
+    InputRecord& Append(InputRecord::Kind kind);
+};
@@ -0,0 +1,145 @@
+#include "InputReplay.hpp"
+
+#include <Aspect_WindowInputListener.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+
+namespace
+{
+    double NowMs()
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+bool InputReplay::Load(const std::string& path, Graphic3d_Vec2i& canvasSize)
+{
+    std::ifstream file(path, std::ios::binary);
+    InputLogHeader header {};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.Magic, "OWIL", 4) != 0 || header.Version != InputRecorder::s_Version) {
+        return false;
+    }
+
+    std::vector<InputRecord> records(header.RecordCount);
+    if (!file.read(reinterpret_cast<char*>(records.data()), records.size() * sizeof(InputRecord))) return false;
+
+    Stop();
+    m_Records = std::move(records);
+    canvasSize.SetValues(header.CanvasWidth, header.CanvasHeight);
+    return true;
+}
+
+void InputReplay::Start(bool toMaxSpeed)
+{
+    m_bMaxSpeed = toMaxSpeed;
+    m_Next = 0;
+    m_FrameMs.clear();
+    m_Stats = {};
+    m_StartMs = NowMs();
+    m_bInFrame = false;
+    m_bPlaying = !m_Records.empty();
+}
+
+void InputReplay::Stop()
+{
+    if (!m_bPlaying) return;
+
+    m_bPlaying = false;
+    m_Stats.WallMs = NowMs() - m_StartMs;
+    UpdateStats();
+}
+
+void InputReplay::BeginFrame(Aspect_WindowInputListener& listener)
+{
+    if (!m_bPlaying) return;
+
+    m_FrameBeginMs = NowMs();
+    m_bInFrame = true;
+    if (m_bMaxSpeed) {
+        for (; m_Next < m_Records.size(); ++m_Next) {
+            if (m_Records[m_Next].EventKind == InputRecord::Kind::Frame) {
+                ++m_Next;
+                break;
+            }
+            Feed(m_Records[m_Next], listener);
+        }
+    }
+    else {
+        const double elapsedUs = (m_FrameBeginMs - m_StartMs) * 1000.0;
+        for (; m_Next < m_Records.size() && m_Records[m_Next].TimeUs <= elapsedUs; ++m_Next) {
+            Feed(m_Records[m_Next], listener);
+        }
+    }
+}
+
+void InputReplay::EndFrame()
+{
+    if (!m_bInFrame) return;
+
+    m_bInFrame = false;
+    m_FrameMs.push_back(static_cast<float>(NowMs() - m_FrameBeginMs));
+    if (m_Next >= m_Records.size()) Stop();
+}
+
+void InputReplay::Feed(const InputRecord& record, Aspect_WindowInputListener& listener)
+{
+    const Graphic3d_Vec2i point(static_cast<int>(record.X), static_cast<int>(record.Y));
+    const Graphic3d_Vec2d touchPoint(record.X, record.Y);
+    const bool isEmulated = false;
+    switch (record.EventKind) {
+    case InputRecord::Kind::MouseMove:
+        listener.UpdateMousePosition(point, record.Buttons, record.Flags, isEmulated);
+        break;
+    case InputRecord::Kind::MouseButtons:
+        listener.UpdateMouseButtons(point, record.Buttons, record.Flags, isEmulated);
+        break;
+    case InputRecord::Kind::Wheel: {
+        Aspect_ScrollDelta delta(point, record.Delta, record.Flags);
+        listener.UpdateMouseScroll(delta);
+        break;
+    }
+    case InputRecord::Kind::TouchAdd:
+        listener.AddTouchPoint(record.Code, touchPoint);
+        break;
+    case InputRecord::Kind::TouchUpdate:
+        listener.UpdateTouchPoint(record.Code, touchPoint);
+        break;
+    case InputRecord::Kind::TouchRemove:
+        listener.RemoveTouchPoint(record.Code);
+        break;
+    case InputRecord::Kind::KeyDown:
+        listener.KeyDown(static_cast<Aspect_VKey>(record.Code), listener.EventTime());
+        break;
+    case InputRecord::Kind::KeyUp:
+        listener.KeyUp(static_cast<Aspect_VKey>(record.Code), listener.EventTime());
+        break;
+    case InputRecord::Kind::Frame:
+        return;
+    }
+    ++m_Stats.EventCount;
+}
+
+void InputReplay::UpdateStats()
+{
+    m_Stats.FrameCount = m_FrameMs.size();
+    if (m_FrameMs.empty()) return;
+
+    std::vector<float> sorted(m_FrameMs);
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0.0;
+    for (float ms : sorted) sum += ms;
+
+    const auto percentile = [&sorted](double ratio) {
+        return sorted[std::min(sorted.size() - 1, static_cast<size_t>(ratio * sorted.size()))];
+    };
+    m_Stats.MeanFrameMs = static_cast<float>(sum / sorted.size());
+    m_Stats.P50FrameMs = percentile(0.50);
+    m_Stats.P95FrameMs = percentile(0.95);
+    m_Stats.P99FrameMs = percentile(0.99);
+    m_Stats.MaxFrameMs = sorted.back();
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "InputRecorder.hpp"
+
+#include <string>
+#include <vector>
+
+class Aspect_WindowInputListener;
+
+
+// Feeds an input log back to the view controller and times the frames drawn meanwhile.
+// At recorded speed events are fed when their timestamp is due, at maximum speed each frame gets the events
+// of one recorded frame, so the same batches are flushed together whatever the frame rate. The caller drives
+// maximum speed frames back to back (see WasmOcctView::startInputReplay()) instead of waiting for the display.
+class InputReplay
+{
+public:
+    struct Stats
+    {
+        size_t FrameCount;
+        size_t EventCount;
+        double WallMs;  // From the first to the last replayed frame
+        float MeanFrameMs;  // Work between BeginFrame() and EndFrame()
+        float P50FrameMs;
+        float P95FrameMs;
+        float P99FrameMs;
+        float MaxFrameMs;
+    };
+
+    // Canvas size of the recording is returned to detect a mismatch with the current one
+    bool Load(const std::string& path, Graphic3d_Vec2i& canvasSize);
+    void Start(bool toMaxSpeed);
+    void Stop();
+    bool IsPlaying() const { return m_bPlaying; }
+
+    // Feeds the events due in this frame, stops after the last one
+    void BeginFrame(Aspect_WindowInputListener& listener);
+    void EndFrame();
+
+    const Stats& GetStats() const { return m_Stats; }
+
+private:
+    std::vector<InputRecord> m_Records;
+    std::vector<float> m_FrameMs;
+    size_t m_Next { 0 };  // Next record to feed
+    double m_StartMs { 0.0 };
+    double m_FrameBeginMs { 0.0 };
+    bool m_bMaxSpeed { false };
+    bool m_bPlaying { false };
+    bool m_bInFrame { false };
+    Stats m_Stats {};
+
+    void Feed(const InputRecord& record, Aspect_WindowInputListener& listener);
+    void UpdateStats();
+};
@@ -0,0 +1,161 @@
+#include "InputRouter.hpp"
+
+#include <Aspect_ScrollDelta.hxx>
+#include <Aspect_WindowInputListener.hxx>
+
+#if defined(__EMSCRIPTEN__)
+#include "GlfwOcctWindow.hpp"
+
+#include <emscripten/html5.h>
+#endif
+
+#include <imgui.h>
+
+#include <cfloat>
+
+
+namespace
+{
+    int UiMouseButton(Aspect_VKeyMouse button)
+    {
+        switch (button) {
+        case Aspect_VKeyMouse_LeftButton:   return ImGuiMouseButton_Left;
+        case Aspect_VKeyMouse_RightButton:  return ImGuiMouseButton_Right;
+        case Aspect_VKeyMouse_MiddleButton: return ImGuiMouseButton_Middle;
+        default:                            return -1;
+        }
+    }
+}
+
+bool InputRouter::Dispatch(const PointerEvent& event, Aspect_WindowInputListener& listener)
+{
+    ++m_Stats.EventCount;
+    const bool isInside = IsInside(event.Position);
+    const bool isViewDragging = listener.PressedMouseButtons() != Aspect_VKeyMouse_NONE;
+
+    // WantCaptureMouse is from the last ImGui frame, it stays set while an ImGui drag is in progress
+    const bool isUiCapturing = ImGui::GetIO().WantCaptureMouse && !isViewDragging;
+    FeedUi(event, isInside);
+
+    if (isUiCapturing) {
+        ++m_Stats.UiEventCount;
+        listener.ProcessInput();  // Only the UI changes, the 3D image stays cached
+        return true;
+    }
+    if (!isInside && !isViewDragging) return false;
+
+    ++m_Stats.ViewEventCount;
+    if (FeedView(event, listener)) {
+        listener.ProcessInput();
+    }
+    return true;
+}
+
+bool InputRouter::IsInside(const Graphic3d_Vec2i& position) const
+{
+    return position.x() >= 0 && position.x() <= m_CanvasSize.x()
+        && position.y() >= 0 && position.y() <= m_CanvasSize.y();
+}
+
+void InputRouter::FeedUi(const PointerEvent& event, bool isInside)
+{
+    ImGuiIO& io = ImGui::GetIO();
+
+    if (event.Flags != m_UiFlags) {
+        const Aspect_VKeyFlags changed = event.Flags ^ m_UiFlags;
+        if (changed & Aspect_VKeyFlags_CTRL)  io.AddKeyEvent(ImGuiKey_ModCtrl, (event.Flags & Aspect_VKeyFlags_CTRL) != 0);
+        if (changed & Aspect_VKeyFlags_SHIFT) io.AddKeyEvent(ImGuiKey_ModShift, (event.Flags & Aspect_VKeyFlags_SHIFT) != 0);
+        if (changed & Aspect_VKeyFlags_ALT)   io.AddKeyEvent(ImGuiKey_ModAlt, (event.Flags & Aspect_VKeyFlags_ALT) != 0);
+        if (changed & Aspect_VKeyFlags_META)  io.AddKeyEvent(ImGuiKey_ModSuper, (event.Flags & Aspect_VKeyFlags_META) != 0);
+        m_UiFlags = event.Flags;
+    }
+
+    // Outside the canvas ImGui only follows a drag, otherwise it is told there is no mouse
+    if (isInside || event.Buttons != Aspect_VKeyMouse_NONE) {
+        io.AddMousePosEvent(static_cast<float>(event.Position.x()), static_cast<float>(event.Position.y()));
+        m_bUiHasPointer = true;
+    }
+    else if (m_bUiHasPointer) {
+        io.AddMousePosEvent(-FLT_MAX, -FLT_MAX);
+        m_bUiHasPointer = false;
+    }
+
+    switch (event.EventType) {
+    case PointerEvent::Type::Down:
+    case PointerEvent::Type::Up: {
+        const int button = UiMouseButton(event.Button);
+        if (button >= 0) io.AddMouseButtonEvent(button, event.EventType == PointerEvent::Type::Down);
+        break;
+    }
+    case PointerEvent::Type::Wheel:
+        if (isInside) io.AddMouseWheelEvent(0.0f, static_cast<float>(event.WheelDelta));
+        break;
+    case PointerEvent::Type::Move:
+        break;
+    }
+}
+
+bool InputRouter::FeedView(const PointerEvent& event, Aspect_WindowInputListener& listener)
+{
+    const bool isEmulated = false;
+    switch (event.EventType) {
+    case PointerEvent::Type::Move:
+        return listener.UpdateMousePosition(event.Position, event.Buttons, event.Flags, isEmulated);
+    case PointerEvent::Type::Down:
+    case PointerEvent::Type::Up:
+        return listener.UpdateMouseButtons(event.Position, event.Buttons, event.Flags, isEmulated);
+    case PointerEvent::Type::Wheel:
+        return listener.UpdateMouseScroll(Aspect_ScrollDelta(event.Position, event.WheelDelta));
+    }
+    return false;
+}
+
+#if defined(__EMSCRIPTEN__)
+bool InputRouter::DecodeMouseEvent(int eventType, const EmscriptenMouseEvent& native, const Graphic3d_Vec2d& canvasOffset,
+                                   double devicePixelRatio, PointerEvent& event)
+{
+    switch (eventType) {
+    case EMSCRIPTEN_EVENT_MOUSEMOVE: event.EventType = PointerEvent::Type::Move; break;
+    case EMSCRIPTEN_EVENT_MOUSEDOWN: event.EventType = PointerEvent::Type::Down; break;
+    case EMSCRIPTEN_EVENT_MOUSEUP:   event.EventType = PointerEvent::Type::Up; break;
+    default: return false;
+    }
+
+    const Graphic3d_Vec2d position = (Graphic3d_Vec2d(native.targetX, native.targetY) - canvasOffset) * devicePixelRatio;
+    event.Position = Graphic3d_Vec2i(position + Graphic3d_Vec2d(0.5));
+    event.Buttons = GlfwOcctWindow::MouseButtonsFromNative(native.buttons);
+    switch (native.button) {
+    case 0:  event.Button = Aspect_VKeyMouse_LeftButton; break;
+    case 1:  event.Button = Aspect_VKeyMouse_MiddleButton; break;
+    case 2:  event.Button = Aspect_VKeyMouse_RightButton; break;
+    default: event.Button = Aspect_VKeyMouse_NONE; break;
+    }
+
+    event.Flags = Aspect_VKeyFlags_NONE;
+    if (native.ctrlKey == EM_TRUE)  event.Flags |= Aspect_VKeyFlags_CTRL;
+    if (native.shiftKey == EM_TRUE) event.Flags |= Aspect_VKeyFlags_SHIFT;
+    if (native.altKey == EM_TRUE)   event.Flags |= Aspect_VKeyFlags_ALT;
+    if (native.metaKey == EM_TRUE)  event.Flags |= Aspect_VKeyFlags_META;
+    event.WheelDelta = 0.0;
+    return true;
+}
+
+bool InputRouter::DecodeWheelEvent(int eventType, const EmscriptenWheelEvent& native, double devicePixelRatio, PointerEvent& event)
+{
+    if (eventType != EMSCRIPTEN_EVENT_WHEEL) return false;
+
+    DecodeMouseEvent(EMSCRIPTEN_EVENT_MOUSEMOVE, native.mouse, Graphic3d_Vec2d(0.0), devicePixelRatio, event);
+    event.EventType = PointerEvent::Type::Wheel;
+    event.Button = Aspect_VKeyMouse_NONE;
+
+    // Same scale as GlfwOcctWindow::ProcessWheelEvent
+    double delta = 0.0;
+    switch (native.deltaMode) {
+    case DOM_DELTA_PIXEL: delta = native.deltaY / (5.0 * devicePixelRatio); break;
+    case DOM_DELTA_LINE:  delta = native.deltaY * 8.0; break;
+    case DOM_DELTA_PAGE:  delta = native.deltaY >= 0.0 ? 24.0 : -24.0; break;
+    }
+    event.WheelDelta = -delta / 15.0;
+    return true;
+}
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Aspect_VKeyFlags.hxx>
+#include <Graphic3d_Vec2.hxx>
+
+#include <cstddef>
+
+class Aspect_WindowInputListener;
+struct EmscriptenMouseEvent;
+struct EmscriptenWheelEvent;
+
+
+// One pointer event decoded from the DOM, in backing store pixels of the canvas
+struct PointerEvent
+{
+    enum class Type { Move, Down, Up, Wheel };
+
+    Type EventType { Type::Move };
+    Graphic3d_Vec2i Position;
+    Aspect_VKeyMouse Buttons { Aspect_VKeyMouse_NONE };  // Pressed after the event
+    Aspect_VKeyMouse Button { Aspect_VKeyMouse_NONE };   // Pressed or released by Down/Up
+    Aspect_VKeyFlags Flags { Aspect_VKeyFlags_NONE };
+    double WheelDelta { 0.0 };                           // Scroll steps, positive away from the user
+};
+
+// Single entry point of pointer input. Each event is decoded once and feeds both ImGui and the 3D view controller:
+// ImGui sees every event so its hover and button states stay consistent, the view controller only gets events
+// ImGui does not capture, except while a 3D drag started outside the UI is in progress.
+class InputRouter
+{
+public:
+    struct Stats
+    {
+        size_t EventCount;
+        size_t UiEventCount;    // Captured by ImGui
+        size_t ViewEventCount;  // Passed to the view controller
+    };
+
+    void SetCanvasSize(const Graphic3d_Vec2i& size) { m_CanvasSize = size; }
+
+    // Returns true if the event was handled (inside the canvas or part of a drag)
+    bool Dispatch(const PointerEvent& event, Aspect_WindowInputListener& listener);
+
+#if defined(__EMSCRIPTEN__)
+    // canvasOffset is subtracted from target coordinates of events bound to the window rather than the canvas
+    static bool DecodeMouseEvent(int eventType, const EmscriptenMouseEvent& native, const Graphic3d_Vec2d& canvasOffset,
+                                 double devicePixelRatio, PointerEvent& event);
+    static bool DecodeWheelEvent(int eventType, const EmscriptenWheelEvent& native, double devicePixelRatio, PointerEvent& event);
+#endif
+
+    const Stats& GetStats() const { return m_Stats; }
+    void ResetStats() { m_Stats = {}; }
+
+private:
+    Graphic3d_Vec2i m_CanvasSize;
+    Aspect_VKeyFlags m_UiFlags { Aspect_VKeyFlags_NONE };  // Modifiers last sent to ImGui
+    bool m_bUiHasPointer { false };                        // ImGui has a valid mouse position
+    Stats m_Stats {};
+
+    bool IsInside(const Graphic3d_Vec2i& position) const;
+    void FeedUi(const PointerEvent& event, bool isInside);
+    bool FeedView(const PointerEvent& event, Aspect_WindowInputListener& listener);
+};
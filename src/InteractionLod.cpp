@@ -0,0 +1,142 @@
+#include "InteractionLod.hpp"
+#include "AppManager.hpp"
+#include "Geometry.hpp"
+#include "PerfOverlay.hpp"
+#include "Trace.hpp"
+
+#include <AIS_ColoredShape.hxx>
+#include <Graphic3d_Camera.hxx>
+#include <Prs3d_LineAspect.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    const int s_BoundingBoxMode = 2;  // AIS_Shape display mode drawing the bounding box
+
+    // Projected diameter of the box's bounding sphere, in pixels
+    double ProjectedSize(const Graphic3d_Camera& camera, double viewportHeight, const Bnd_Box& box)
+    {
+        if (box.IsVoid()) return 0.0;
+
+        const double diameter = std::sqrt(box.SquareExtent());
+        double viewHeight = camera.ViewDimensions().Y();  // At the focal distance for perspective cameras
+        if (!camera.IsOrthographic()) {
+            const gp_Pnt center = (box.CornerMin().XYZ() + box.CornerMax().XYZ()) * 0.5;
+            const double distance = std::max(camera.Eye().Distance(center), camera.ZNear());
+            viewHeight = 2.0 * distance * std::tan(camera.FOVy() * M_PI / 360.0);
+        }
+        return viewHeight > 0.0 ? diameter / viewHeight * viewportHeight : 0.0;
+    }
+}
+
+bool InteractionLod::Update(const Handle(AIS_InteractiveContext)& context, const Handle(V3d_View)& view, bool isInteracting, double nowMs)
+{
+    if (!m_Settings.Enabled || m_bSuspended) {
+        if (!IsActive()) return false;
+        Restore(context);
+        return true;
+    }
+
+    if (isInteracting) {
+        const bool isStarting = nowMs - m_LastInteractionMs >= m_Settings.RestDelayMs && !IsActive();
+        m_LastInteractionMs = nowMs;
+        if (isStarting || nowMs - m_LastApplyMs >= m_Settings.RefreshMs) {
+            Apply(context, view, nowMs);
+            return true;
+        }
+        return false;
+    }
+
+    if (IsActive() && nowMs - m_LastInteractionMs >= m_Settings.RestDelayMs) {
+        Restore(context);
+        return true;
+    }
+    return false;
+}
+
+void InteractionLod::Apply(const Handle(AIS_InteractiveContext)& context, const Handle(V3d_View)& view, double nowMs)
+{
+    TRACE_SCOPE("InteractionLod::Apply");
+    m_LastApplyMs = nowMs;
+
+    Standard_Integer width = 0;
+    Standard_Integer height = 0;
+    view->Window()->Size(width, height);
+    const Graphic3d_Camera& camera = *view->Camera();
+
+    m_Geometries.clear();
+    AppManager::GetInstance().GetDisplayedGeometry(m_Geometries);
+    for (const DisplayedGeometry& displayed : m_Geometries) {
+        const Handle(AIS_ColoredShape) shape = displayed.pGeometry->GetShape();
+        if (shape.IsNull()) continue;
+
+        const bool isProxy = ProjectedSize(camera, height, *displayed.pWorldBox) < m_Settings.ProxyPixels;
+        const bool hideBoundaries = !isProxy && m_Settings.HideBoundaries && shape->Attributes()->FaceBoundaryDraw();
+        auto it = m_Lowered.find(shape.get());
+        if (it == m_Lowered.end()) {
+            if (!isProxy && !hideBoundaries) continue;
+            it = m_Lowered.emplace(shape.get(), Entry()).first;
+            it->second.Object = shape;
+        }
+
+        Entry& entry = it->second;
+        SetProxy(context, entry, isProxy);
+        SetBoundariesHidden(entry, hideBoundaries);
+        if (!entry.IsProxy && !entry.HasHiddenBoundaries) m_Lowered.erase(it);
+    }
+
+    m_Stats.ProxyCount = 0;
+    for (const auto& lowered : m_Lowered) {
+        if (lowered.second.IsProxy) ++m_Stats.ProxyCount;
+    }
+    m_Stats.LoweredCount = m_Lowered.size();
+    m_Stats.LastApplyMs = PerfOverlay::NowMs() - nowMs;
+}
+
+void InteractionLod::Restore(const Handle(AIS_InteractiveContext)& context)
+{
+    TRACE_SCOPE("InteractionLod::Restore");
+    for (auto& lowered : m_Lowered) {
+        SetProxy(context, lowered.second, false);
+        SetBoundariesHidden(lowered.second, false);
+    }
+    m_Lowered.clear();
+    m_Stats.ProxyCount = 0;
+    m_Stats.LoweredCount = 0;
+}
+
+void InteractionLod::SetProxy(const Handle(AIS_InteractiveContext)& context, Entry& entry, bool proxy)
+{
+    if (entry.IsProxy == proxy) return;
+
+    entry.IsProxy = proxy;
+    ++m_Stats.SwitchCount;
+    if (proxy) {
+        context->SetDisplayMode(entry.Object, s_BoundingBoxMode, Standard_False);
+    }
+    else {
+        context->UnsetDisplayMode(entry.Object, Standard_False);  // Back to the context default (shaded)
+    }
+}
+
+void InteractionLod::SetBoundariesHidden(Entry& entry, bool hidden)
+{
+    if (entry.HasHiddenBoundaries == hidden) return;
+
+    // Each geometry owns its boundary aspect (see GeometryManager::AddGeometryToTree), changing its line type
+    // hides the boundaries in place, without recomputing the shaded presentation
+    const Handle(Prs3d_LineAspect)& aspect = entry.Object->Attributes()->FaceBoundaryAspect();
+    if (hidden) {
+        entry.BoundaryType = aspect->Aspect()->LineType();
+        aspect->SetTypeOfLine(Aspect_TOL_EMPTY);
+    }
+    else {
+        aspect->SetTypeOfLine(entry.BoundaryType);
+    }
+    entry.HasHiddenBoundaries = hidden;
+    entry.Object->SynchronizeAspects();
+    ++m_Stats.SwitchCount;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "GeometryManager.hpp"
+
+#include <AIS_InteractiveContext.hxx>
+#include <Aspect_TypeOfLine.hxx>
+#include <V3d_View.hxx>
+
+#include <unordered_map>
+#include <vector>
+
+
+// Cheaper presentations while the user navigates, chosen by the projected size of each geometry:
+// geometry smaller than ProxyPixels on screen is drawn as its bounding box (AIS_Shape display mode 2),
+// face boundaries of the rest are hidden. Full detail comes back once the view has been idle for RestDelayMs.
+// Both switches reuse computed presentations, bounding boxes are computed once and boundaries only change aspect.
+class InteractionLod
+{
+public:
+    struct Settings
+    {
+        bool Enabled { false };
+        double ProxyPixels { 24.0 };  // Projected diameter under which geometry becomes a box
+        bool HideBoundaries { true };
+        double RestDelayMs { 200.0 };
+        double RefreshMs { 250.0 };   // Projected sizes are re-evaluated at this interval during long interactions
+    };
+
+    struct Stats
+    {
+        size_t ProxyCount;      // Currently drawn as boxes
+        size_t LoweredCount;    // Currently below full detail (boxes or no boundaries)
+        size_t SwitchCount;     // Total presentation switches
+        double LastApplyMs;     // Duration of the last evaluation
+    };
+
+    Settings& ChangeSettings() { return m_Settings; }
+    const Stats& GetStats() const { return m_Stats; }
+    bool IsActive() const { return !m_Lowered.empty(); }
+    // Suspended while the scene is drawn as merged batches, the per-solid objects it switches are not displayed then
+    void SetSuspended(bool suspended) { m_bSuspended = suspended; }
+    bool IsSuspended() const { return m_bSuspended; }
+
+    // Returns true when presentations changed and the view must be redrawn
+    bool Update(const Handle(AIS_InteractiveContext)& context, const Handle(V3d_View)& view, bool isInteracting, double nowMs);
+    // Back to full detail
+    void Restore(const Handle(AIS_InteractiveContext)& context);
+
+private:
+    struct Entry
+    {
+        Handle(AIS_InteractiveObject) Object;
+        bool IsProxy { false };
+        bool HasHiddenBoundaries { false };
+        Aspect_TypeOfLine BoundaryType { Aspect_TOL_SOLID };
+    };
+
+    Settings m_Settings;
+    Stats m_Stats {};
+    bool m_bSuspended { false };
+    std::unordered_map<const AIS_InteractiveObject*, Entry> m_Lowered;
+    std::vector<DisplayedGeometry> m_Geometries;  // Reused between evaluations
+    double m_LastInteractionMs { 0.0 };
+    double m_LastApplyMs { -1.0e9 };
+
+    void Apply(const Handle(AIS_InteractiveContext)& context, const Handle(V3d_View)& view, double nowMs);
+    void SetBoundariesHidden(Entry& entry, bool hidden);
+    void SetProxy(const Handle(AIS_InteractiveContext)& context, Entry& entry, bool proxy);
+};
@@ -1,11 +1,22 @@
+#pragma once
+
+#include <utility>
+
+
 template<typename T>
 class LCRSNode {
 public:
     // Constructor
     LCRSNode() = delete;
 
-    LCRSNode(T data)
-        : m_Data(data), m_Child(nullptr), m_Sibling(nullptr) {}
+    // Constructs the data in place from the given arguments.
+    template<typename... Args>
+    explicit LCRSNode(Args&&... args)
+        : m_Data(std::forward<Args>(args)...), m_Child(nullptr), m_LastChild(nullptr), m_Sibling(nullptr) {}
+
+    // Nodes own their child and sibling chains.
+    LCRSNode(const LCRSNode& other) = delete;
+    LCRSNode& operator=(const LCRSNode& other) = delete;
 
     // Destructor
     ~LCRSNode() {
@@ -23,12 +34,27 @@ public:
 
     void SetChild(LCRSNode* child) {
         m_Child = child;
+        m_LastChild = child;
+        while (m_LastChild && m_LastChild->GetSibling()) {
+            m_LastChild = m_LastChild->GetSibling();
+        }
     }
 
     LCRSNode* GetChild() const {
         return m_Child;
     }
 
+    // Appends child after the last child in constant time.
+    void AppendChild(LCRSNode* child) {
+        if (m_LastChild) {
+            m_LastChild->SetSibling(child);
+        }
+        else {
+            m_Child = child;
+        }
+        m_LastChild = child;
+    }
+
     void SetSibling(LCRSNode* sibling) {
         m_Sibling = sibling;
     }
@@ -40,6 +66,7 @@ public:
 private:
     T m_Data;
     LCRSNode* m_Child;
+    LCRSNode* m_LastChild;
     LCRSNode* m_Sibling;
 
     void DeleteNode(LCRSNode* node) {
@@ -47,4 +74,4 @@ private:
         delete node;
         node = nullptr;
     }
-};
\ No newline at end of file
+};
@@ -3,6 +3,7 @@
 #include "LCRSNode.hpp"
 
 #include <iostream>
+#include <utility>
 
 
 template<typename T>
@@ -22,24 +23,19 @@ public:
         return m_RootNode;
     }
 
-    // If insertAfter is nullptr, data is set at root node.
-    LCRSNode<T>* InsertItem(T data, LCRSNode<T>* insertAfter = nullptr) {
-        if (!insertAfter) {
-            return SetRoot(data);
-        }
-
-        LCRSNode<T>* newNode = new LCRSNode<T>(data);
-        LCRSNode<T>* childNode = insertAfter->GetChild();
-        if (childNode) {
-            while (childNode->GetSibling()) {
-                childNode = childNode->GetSibling();
-            }
-            childNode->SetSibling(newNode);
-        }
-        else {
-            insertAfter->SetChild(newNode);
-        }
+    // Replaces the root by a node whose data is constructed in place.
+    template<typename... Args>
+    LCRSNode<T>* EmplaceRoot(Args&&... args) {
+        if (m_RootNode) delete m_RootNode;
+        m_RootNode = new LCRSNode<T>(std::forward<Args>(args)...);
+        return m_RootNode;
+    }
 
+    // Appends a last child to parent whose data is constructed in place.
+    template<typename... Args>
+    LCRSNode<T>* EmplaceChild(LCRSNode<T>* parent, Args&&... args) {
+        LCRSNode<T>* newNode = new LCRSNode<T>(std::forward<Args>(args)...);
+        parent->AppendChild(newNode);
         return newNode;
     }
 
@@ -58,12 +54,27 @@ public:
         }
     }
 
-private:
-    LCRSNode<T>* m_RootNode;
+    // Same traversal as LoopTree for any callable, e.g. a capturing lambda.
+    template<typename Func>
+    void ForEachNode(LCRSNode<T>* node, Func&& func, int depth = 0)
+    {
+        for (; node; node = node->GetSibling()) {
+            func(node, depth);
+            ForEachNode(node->GetChild(), func, depth + 1);
+        }
+    }
 
-    LCRSNode<T>* SetRoot(T data) {
-        if (m_RootNode) delete m_RootNode;
-        m_RootNode = new LCRSNode<T>(data);
-        return m_RootNode;
+    // Depth-first search from node, returns the first node satisfying pred or nullptr.
+    template<typename Pred>
+    LCRSNode<T>* FindNode(LCRSNode<T>* node, Pred pred) const
+    {
+        for (; node; node = node->GetSibling()) {
+            if (pred(node)) return node;
+            if (LCRSNode<T>* found = FindNode(node->GetChild(), pred)) return found;
+        }
+        return nullptr;
     }
+
+private:
+    LCRSNode<T>* m_RootNode;
 };
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "MemoryFootprint.hpp"
+
+#include <BRep_CurveRepresentation.hxx>
+#include <BRep_ListOfCurveRepresentation.hxx>
+#include <BRep_TEdge.hxx>
+#include <BRep_Tool.hxx>
+#include <Geom2d_BSplineCurve.hxx>
+#include <Geom2d_Curve.hxx>
+#include <Geom_BSplineCurve.hxx>
+#include <Geom_BSplineSurface.hxx>
+#include <Geom_BezierSurface.hxx>
+#include <Geom_Curve.hxx>
+#include <Geom_Surface.hxx>
+#include <Poly_PolygonOnTriangulation.hxx>
+#include <Poly_Triangulation.hxx>
+#include <SelectMgr_SelectableObject.hxx>
+#include <SelectMgr_Selection.hxx>
+#include <SelectMgr_SensitiveEntity.hxx>
+#include <Select3D_SensitiveSet.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Iterator.hxx>
+#include <gp_Pnt2d.hxx>
+#include <gp_Vec3f.hxx>
+
+
+namespace
+{
+    size_t TransientBytes(const Handle(Standard_Transient)& object)
+    {
+        return object.IsNull() ? 0 : object->DynamicType()->Size();
+    }
+
+    size_t KnotBytes(int nbKnots)
+    {
+        return nbKnots * (sizeof(double) + sizeof(int));  // Knots and multiplicities
+    }
+
+    size_t SurfaceBytes(const Handle(Geom_Surface)& surface)
+    {
+        size_t bytes = TransientBytes(surface);
+        if (Handle(Geom_BSplineSurface) bspline = Handle(Geom_BSplineSurface)::DownCast(surface)) {
+            const size_t nbPoles = static_cast<size_t>(bspline->NbUPoles()) * bspline->NbVPoles();
+            bytes += nbPoles * sizeof(gp_Pnt);
+            if (bspline->IsURational() || bspline->IsVRational()) bytes += nbPoles * sizeof(double);
+            bytes += KnotBytes(bspline->NbUKnots()) + KnotBytes(bspline->NbVKnots());
+        }
+        else if (Handle(Geom_BezierSurface) bezier = Handle(Geom_BezierSurface)::DownCast(surface)) {
+            bytes += static_cast<size_t>(bezier->NbUPoles()) * bezier->NbVPoles() * (sizeof(gp_Pnt) + sizeof(double));
+        }
+        return bytes;
+    }
+
+    size_t CurveBytes(const Handle(Geom_Curve)& curve)
+    {
+        size_t bytes = TransientBytes(curve);
+        if (Handle(Geom_BSplineCurve) bspline = Handle(Geom_BSplineCurve)::DownCast(curve)) {
+            bytes += bspline->NbPoles() * (sizeof(gp_Pnt) + (bspline->IsRational() ? sizeof(double) : 0));
+            bytes += KnotBytes(bspline->NbKnots());
+        }
+        return bytes;
+    }
+
+    size_t Curve2dBytes(const Handle(Geom2d_Curve)& curve)
+    {
+        size_t bytes = TransientBytes(curve);
+        if (Handle(Geom2d_BSplineCurve) bspline = Handle(Geom2d_BSplineCurve)::DownCast(curve)) {
+            bytes += bspline->NbPoles() * (sizeof(gp_Pnt2d) + (bspline->IsRational() ? sizeof(double) : 0));
+            bytes += KnotBytes(bspline->NbKnots());
+        }
+        return bytes;
+    }
+
+    size_t TriangulationBytes(const Handle(Poly_Triangulation)& triangulation)
+    {
+        const size_t nbNodes = triangulation->NbNodes();
+        size_t bytes = TransientBytes(triangulation);
+        bytes += nbNodes * sizeof(gp_Pnt);
+        if (triangulation->HasUVNodes()) bytes += nbNodes * sizeof(gp_Pnt2d);
+        if (triangulation->HasNormals()) bytes += nbNodes * sizeof(gp_Vec3f);
+        bytes += triangulation->NbTriangles() * sizeof(Poly_Triangle);
+        return bytes;
+    }
+
+    size_t PolygonOnTriangulationBytes(const Handle(Poly_PolygonOnTriangulation)& polygon)
+    {
+        size_t bytes = TransientBytes(polygon) + polygon->NbNodes() * sizeof(int);
+        if (polygon->HasParameters()) bytes += polygon->NbNodes() * sizeof(double);
+        return bytes;
+    }
+
+    void AddEdgeRepresentations(const TopoDS_Edge& edge, Footprint::VisitedSet& visited, MemoryFootprint& footprint)
+    {
+        Handle(BRep_TEdge) tEdge = Handle(BRep_TEdge)::DownCast(edge.TShape());
+        if (tEdge.IsNull()) return;
+
+        for (BRep_ListIteratorOfListOfCurveRepresentation it(tEdge->Curves()); it.More(); it.Next()) {
+            const Handle(BRep_CurveRepresentation)& representation = it.Value();
+            footprint.BRep += TransientBytes(representation);
+
+            if (representation->IsCurve3D()) {
+                const Handle(Geom_Curve)& curve = representation->Curve3D();
+                if (!curve.IsNull() && visited.insert(curve.get()).second) footprint.BRep += CurveBytes(curve);
+            }
+            else if (representation->IsCurveOnSurface()) {
+                footprint.BRep += Curve2dBytes(representation->PCurve());
+                if (representation->IsCurveOnClosedSurface()) footprint.BRep += Curve2dBytes(representation->PCurve2());
+            }
+            else if (representation->IsPolygonOnTriangulation()) {
+                footprint.Triangulation += PolygonOnTriangulationBytes(representation->PolygonOnTriangulation());
+                if (representation->IsPolygonOnClosedTriangulation()) {
+                    footprint.Triangulation += PolygonOnTriangulationBytes(representation->PolygonOnTriangulation2());
+                }
+            }
+        }
+    }
+}
+
+void Footprint::AddShape(const TopoDS_Shape& shape, VisitedSet& visited, MemoryFootprint& footprint)
+{
+    if (shape.IsNull() || !visited.insert(shape.TShape().get()).second) return;
+
+    footprint.BRep += TransientBytes(shape.TShape());
+
+    if (shape.ShapeType() == TopAbs_FACE) {
+        const TopoDS_Face& face = TopoDS::Face(shape);
+        TopLoc_Location location;
+        const Handle(Geom_Surface)& surface = BRep_Tool::Surface(face, location);
+        if (!surface.IsNull() && visited.insert(surface.get()).second) footprint.BRep += SurfaceBytes(surface);
+
+        const Handle(Poly_Triangulation)& triangulation = BRep_Tool::Triangulation(face, location);
+        if (!triangulation.IsNull() && visited.insert(triangulation.get()).second) {
+            footprint.Triangulation += TriangulationBytes(triangulation);
+        }
+    }
+    else if (shape.ShapeType() == TopAbs_EDGE) {
+        AddEdgeRepresentations(TopoDS::Edge(shape), visited, footprint);
+    }
+
+    for (TopoDS_Iterator it(shape, Standard_False, Standard_False); it.More(); it.Next()) {
+        footprint.BRep += sizeof(TopoDS_Shape) + sizeof(void*);  // Entry in the parent's list of sub-shapes
+        AddShape(it.Value(), visited, footprint);
+    }
+}
+
+size_t Footprint::EstimateSelectionBytes(const Handle(SelectMgr_SelectableObject)& object)
+{
+    // BVH over the elements of a sensitive set: one index per element and roughly one node (box and links) per element
+    const size_t bvhBytesPerElement = sizeof(int) + 2 * 3 * sizeof(double) + 4 * sizeof(int);
+
+    size_t bytes = 0;
+    for (SelectMgr_SequenceOfSelection::Iterator selIt(object->Selections()); selIt.More(); selIt.Next()) {
+        const Handle(SelectMgr_Selection)& selection = selIt.Value();
+        bytes += TransientBytes(selection);
+        for (NCollection_Vector<Handle(SelectMgr_SensitiveEntity)>::Iterator entIt(selection->Entities()); entIt.More(); entIt.Next()) {
+            const Handle(Select3D_SensitiveEntity)& sensitive = entIt.Value()->BaseSensitive();
+            bytes += TransientBytes(entIt.Value()) + TransientBytes(sensitive);
+            if (!sensitive.IsNull() && sensitive->IsKind(STANDARD_TYPE(Select3D_SensitiveSet))) {
+                bytes += sensitive->NbSubElements() * bvhBytesPerElement;
+            }
+        }
+    }
+    return bytes;
+}
+
+size_t Footprint::EstimateIndexMapBytes(const TopTools_IndexedMapOfShape& map)
+{
+    // Each key lives in a node linked from two bucket arrays (by key and by index)
+    const size_t nodeBytes = sizeof(TopoDS_Shape) + sizeof(int) + 2 * sizeof(void*);
+    return map.Extent() * nodeBytes + (map.NbBuckets() + 1) * 2 * sizeof(void*);
+}
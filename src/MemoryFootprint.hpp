@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Standard_Handle.hxx>
+
+#include <cstddef>
+#include <unordered_set>
+
+class TopoDS_Shape;
+class SelectMgr_SelectableObject;
+class TopTools_IndexedMapOfShape;
+
+
+// Estimated bytes held by one geometry, split by owner.
+// Figures are computed from element counts and OCCT object sizes, they are meant for budgeting rather than exact accounting.
+struct MemoryFootprint
+{
+    size_t BRep { 0 };           // Topology, curves and surfaces
+    size_t Triangulation { 0 };  // Poly_Triangulation of faces and polygons on triangulation of edges
+    size_t Presentation { 0 };   // Primitive arrays and GPU buffers of computed presentations
+    size_t Selection { 0 };      // Sensitive entities and their BVH
+    size_t IndexMap { 0 };       // Vertex/edge/face index maps used for sub-shape picking
+
+    size_t Total() const { return BRep + Triangulation + Presentation + Selection + IndexMap; }
+
+    MemoryFootprint& operator+=(const MemoryFootprint& other)
+    {
+        BRep += other.BRep;
+        Triangulation += other.Triangulation;
+        Presentation += other.Presentation;
+        Selection += other.Selection;
+        IndexMap += other.IndexMap;
+        return *this;
+    }
+};
+
+namespace Footprint
+{
+    // Data already accounted for (TShapes, geometries, triangulations), so shared data is charged once
+    using VisitedSet = std::unordered_set<const void*>;
+
+    // Adds B-Rep and triangulation bytes of shape and all its sub-shapes not in visited yet
+    void AddShape(const TopoDS_Shape& shape, VisitedSet& visited, MemoryFootprint& footprint);
+
+    size_t EstimateSelectionBytes(const Handle(SelectMgr_SelectableObject)& object);
+    size_t EstimateIndexMapBytes(const TopTools_IndexedMapOfShape& map);
+}
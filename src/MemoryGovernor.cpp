@@ -0,0 +1,88 @@
+#include "MemoryGovernor.hpp"
+
+#include <algorithm>
+
+
+void MemoryGovernor::OnShown(int geometryID, size_t bytes)
+{
+    Entry& entry = m_Entries[geometryID];
+    switch (entry.State) {
+    case ResidencyState::Hidden:
+        m_HiddenLru.erase(entry.LruIt);
+        m_Stats.ResidentBytes -= entry.Bytes;
+        break;
+    case ResidencyState::Evicted:
+        ++m_Stats.RebuildCount;
+        --m_Stats.EvictedCount;
+        break;
+    case ResidencyState::Visible:
+        m_Stats.ResidentBytes -= entry.Bytes;  // Bytes are re-measured
+        break;
+    }
+    entry.State = ResidencyState::Visible;
+    entry.Bytes = bytes;
+    m_Stats.ResidentBytes += bytes;
+    m_Stats.PeakResidentBytes = std::max(m_Stats.PeakResidentBytes, m_Stats.ResidentBytes);
+}
+
+void MemoryGovernor::OnHidden(int geometryID)
+{
+    auto it = m_Entries.find(geometryID);
+    if (it == m_Entries.end() || it->second.State != ResidencyState::Visible) return;
+
+    Entry& entry = it->second;
+    entry.State = ResidencyState::Hidden;
+    entry.LruIt = m_HiddenLru.insert(m_HiddenLru.end(), geometryID);
+}
+
+void MemoryGovernor::OnEvicted(int geometryID)
+{
+    auto it = m_Entries.find(geometryID);
+    if (it == m_Entries.end() || it->second.State != ResidencyState::Hidden) return;
+
+    Entry& entry = it->second;
+    m_HiddenLru.erase(entry.LruIt);
+    entry.State = ResidencyState::Evicted;
+    m_Stats.ResidentBytes -= entry.Bytes;
+    m_Stats.EvictedBytes += entry.Bytes;
+    ++m_Stats.EvictionCount;
+    ++m_Stats.EvictedCount;
+}
+
+void MemoryGovernor::SetBytes(int geometryID, size_t bytes)
+{
+    auto it = m_Entries.find(geometryID);
+    if (it == m_Entries.end() || it->second.State == ResidencyState::Evicted) return;
+
+    m_Stats.ResidentBytes = m_Stats.ResidentBytes - it->second.Bytes + bytes;
+    it->second.Bytes = bytes;
+    m_Stats.PeakResidentBytes = std::max(m_Stats.PeakResidentBytes, m_Stats.ResidentBytes);
+}
+
+bool MemoryGovernor::IsEvicted(int geometryID) const
+{
+    auto it = m_Entries.find(geometryID);
+    return it != m_Entries.end() && it->second.State == ResidencyState::Evicted;
+}
+
+bool MemoryGovernor::IsResident(int geometryID) const
+{
+    auto it = m_Entries.find(geometryID);
+    return it != m_Entries.end() && it->second.State != ResidencyState::Evicted;
+}
+
+void MemoryGovernor::CollectEvictions(std::vector<int>& geometryIDs) const
+{
+    size_t resident = m_Stats.ResidentBytes;
+    for (auto it = m_HiddenLru.begin(); it != m_HiddenLru.end() && resident > m_Stats.BudgetBytes; ++it) {
+        geometryIDs.push_back(*it);
+        resident -= m_Entries.at(*it).Bytes;
+    }
+}
+
+void MemoryGovernor::Clear()
+{
+    m_Entries.clear();
+    m_HiddenLru.clear();
+    m_Stats = { m_Stats.BudgetBytes, 0, 0, 0, 0, 0, 0 };
+}
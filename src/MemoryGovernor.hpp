@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+
+// Keeps the rendering resources (presentations, selection structures, triangulations) of the scene under a budget.
+// Geometries report when they become resident or hidden; when resident bytes exceed the budget,
+// hidden geometries are picked for eviction in least recently hidden order. Visible geometry is never evicted.
+class MemoryGovernor
+{
+public:
+    struct Stats
+    {
+        size_t BudgetBytes;
+        size_t ResidentBytes;
+        size_t EvictedCount;     // Geometries currently evicted
+        size_t EvictionCount;    // Total evictions
+        size_t RebuildCount;     // Total rebuilds of evicted geometries
+        size_t EvictedBytes;     // Total bytes released
+        size_t PeakResidentBytes;
+    };
+
+    static constexpr size_t s_Unlimited = static_cast<size_t>(-1);
+
+    void SetBudget(size_t bytes) { m_Stats.BudgetBytes = bytes; }
+    size_t GetBudget() const { return m_Stats.BudgetBytes; }
+
+    // Geometry is displayed with bytes of resources (again). Counts a rebuild if it had been evicted.
+    void OnShown(int geometryID, size_t bytes);
+    // Geometry is erased or culled and becomes an eviction candidate
+    void OnHidden(int geometryID);
+    void OnEvicted(int geometryID);
+    // Re-measured resources of a resident geometry, its state is unchanged
+    void SetBytes(int geometryID, size_t bytes);
+
+    bool IsEvicted(int geometryID) const;
+    bool IsResident(int geometryID) const;  // Known and not evicted
+    bool IsOverBudget() const { return m_Stats.ResidentBytes > m_Stats.BudgetBytes; }
+
+    // Appends the hidden geometries to evict, least recently hidden first, so that resident bytes fit the budget
+    void CollectEvictions(std::vector<int>& geometryIDs) const;
+
+    void Clear();
+    const Stats& GetStats() const { return m_Stats; }
+
+private:
+    enum class ResidencyState { Visible, Hidden, Evicted };
+
+    struct Entry
+    {
+        size_t Bytes { 0 };
+        ResidencyState State { ResidencyState::Visible };
+        std::list<int>::iterator LruIt;  // Valid while Hidden
+    };
+
+    std::unordered_map<int, Entry> m_Entries;
+    std::list<int> m_HiddenLru;  // Front: least recently hidden
+    Stats m_Stats { s_Unlimited, 0, 0, 0, 0, 0, 0 };
+};
@@ -0,0 +1,109 @@
+#include "MemoryPanel.hpp"
+#include "AppManager.hpp"
+
+#include <emscripten.h>
+#include <imgui.h>
+
+#include <cstdint>
+
+
+namespace
+{
+    void BytesColumn(size_t bytes)
+    {
+        ImGui::TableNextColumn();
+        if (bytes >= 1024 * 1024) ImGui::Text("%.1f MB", bytes / (1024.0 * 1024.0));
+        else if (bytes >= 1024) ImGui::Text("%.1f KB", bytes / 1024.0);
+        else ImGui::Text("%zu B", bytes);
+    }
+}
+
+void MemoryPanel::Refresh()
+{
+    AppManager::GetInstance().GetMemoryReport(m_Report);
+    m_bStale = false;
+}
+
+void MemoryPanel::Draw()
+{
+    if (!m_bVisible) {
+        m_bStale = true;  // Recompute when the panel is opened again
+        return;
+    }
+    if (m_bStale) Refresh();
+
+    ImGui::SetNextWindowSize(ImVec2(640.0f, 360.0f), ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Memory", &m_bVisible)) {
+        if (ImGui::Button("Refresh")) Refresh();
+        ImGui::SameLine();
+        if (ImGui::Button("Export JSON")) {
+            EM_ASM({ if (Module.downloadMemoryReport) Module.downloadMemoryReport(); });
+        }
+        ImGui::SameLine();
+        ImGui::Checkbox("Subtree totals", &m_bShowSubtree);
+
+        ImGui::SetNextItemWidth(120.0f);
+        if (ImGui::InputInt("Budget (MB, 0: unlimited)", &m_BudgetMB, 16, 128, ImGuiInputTextFlags_EnterReturnsTrue)) {
+            if (m_BudgetMB < 0) m_BudgetMB = 0;
+            AppManager::GetInstance().SetMemoryBudget(m_BudgetMB > 0 ? static_cast<size_t>(m_BudgetMB) * 1024 * 1024 : MemoryGovernor::s_Unlimited);
+            m_bStale = true;
+        }
+        const MemoryGovernor::Stats& stats = AppManager::GetInstance().GetMemoryGovernorStats();
+        ImGui::Text("Resident %.1f MB (peak %.1f MB), evicted %zu (%zu evictions, %zu rebuilds, %.1f MB released)",
+                    stats.ResidentBytes / (1024.0 * 1024.0), stats.PeakResidentBytes / (1024.0 * 1024.0),
+                    stats.EvictedCount, stats.EvictionCount, stats.RebuildCount, stats.EvictedBytes / (1024.0 * 1024.0));
+        const PartStore::Stats& storeStats = AppManager::GetInstance().GetPartStoreStats();
+        if (storeStats.StoredCount > 0) {
+            ImGui::Text("Part store %zu parts, %.1f MB, %zu loads (avg %.2f ms, max %.2f ms)",
+                        storeStats.StoredCount, storeStats.StoredBytes / (1024.0 * 1024.0), storeStats.LoadCount,
+                        storeStats.LoadCount > 0 ? storeStats.TotalLoadMs / storeStats.LoadCount : 0.0, storeStats.MaxLoadMs);
+        }
+
+        const ImGuiTableFlags flags = ImGuiTableFlags_BordersV | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+        if (ImGui::BeginTable("MemoryTable", 7, flags)) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Geometry", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("B-Rep");
+            ImGui::TableSetupColumn("Mesh");
+            ImGui::TableSetupColumn("Presentation");
+            ImGui::TableSetupColumn("Selection");
+            ImGui::TableSetupColumn("Index maps");
+            ImGui::TableSetupColumn("Total");
+            ImGui::TableHeadersRow();
+
+            for (size_t i = 0; i < m_Report.size(); i = m_Report[i].SubtreeEnd) {
+                DrawNode(i);
+            }
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+}
+
+void MemoryPanel::DrawNode(size_t index)
+{
+    const GeometryMemoryInfo& info = m_Report[index];
+    const bool hasChildren = info.SubtreeEnd > index + 1;
+
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanFullWidth;
+    if (!hasChildren) flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+    const bool open = ImGui::TreeNodeEx(reinterpret_cast<void*>(static_cast<intptr_t>(info.GeometryID)), flags,
+                                        "%.*s", static_cast<int>(info.Name.size()), info.Name.data());
+
+    const MemoryFootprint& footprint = m_bShowSubtree ? info.Subtree : info.Own;
+    BytesColumn(footprint.BRep);
+    BytesColumn(footprint.Triangulation);
+    BytesColumn(footprint.Presentation);
+    BytesColumn(footprint.Selection);
+    BytesColumn(footprint.IndexMap);
+    BytesColumn(footprint.Total());
+
+    if (open && hasChildren) {
+        for (size_t i = index + 1; i < info.SubtreeEnd; i = m_Report[i].SubtreeEnd) {
+            DrawNode(i);
+        }
+        ImGui::TreePop();
+    }
+}
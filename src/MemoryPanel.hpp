@@ -0,0 +1,28 @@
+#pragma once
+
+#include "GeometryManager.hpp"
+
+#include <vector>
+
+
+// ImGui tree of the per-geometry memory report with subtree totals.
+// The report is a snapshot, it is only recomputed on Refresh().
+class MemoryPanel
+{
+public:
+    void Refresh();
+    void Draw();
+    void Invalidate() { m_bStale = true; }  // The snapshot names point into the scene's StringTable
+
+    bool IsVisible() const { return m_bVisible; }
+    bool* GetVisiblePtr() { return &m_bVisible; }
+
+private:
+    std::vector<GeometryMemoryInfo> m_Report;
+    bool m_bVisible { false };
+    bool m_bShowSubtree { true };  // Subtree totals or node-only figures
+    bool m_bStale { true };
+    int m_BudgetMB { 0 };  // 0: unlimited
+
+    void DrawNode(size_t index);
+};
@@ -0,0 +1,289 @@
+#include "MergedBatch.hpp"
+
+#include <AIS_InteractiveContext.hxx>
+#include <BRepAdaptor_Surface.hxx>
+#include <BRep_Tool.hxx>
+#include <Graphic3d_AspectFillArea3d.hxx>
+#include <Graphic3d_Group.hxx>
+#include <Poly_PolygonOnTriangulation.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Prs3d_Drawer.hxx>
+#include <Prs3d_LineAspect.hxx>
+#include <Prs3d_ShadingAspect.hxx>
+#include <PrsMgr_PresentationManager.hxx>
+#include <Select3D_SensitivePrimitiveArray.hxx>
+#include <SelectMgr_Selection.hxx>
+#include <StdPrs_ToolTriangulatedShape.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
+#include <TopoDS.hxx>
+
+#include <utility>
+
+
+MergedBatch::MergedBatch(const Quantity_Color& color, VertexFormat format)
+    : m_Format(format)
+{
+    myDrawer->SetupOwnShadingAspect();
+    myDrawer->ShadingAspect()->SetColor(color);
+    if (m_Format == VertexFormat::NoNormals) {
+        // Normals come from screen-space derivatives of the position, see OpenGl_ShaderManager
+        myDrawer->ShadingAspect()->Aspect()->SetShadingModel(Graphic3d_TypeOfShadingModel_PhongFacet);
+    }
+    // Same boundary style as the per-solid objects, see GeometryManager::AddGeometryToTree()
+    myDrawer->SetFaceBoundaryAspect(new Prs3d_LineAspect(color, Aspect_TOL_SOLID, 2.0));
+    myDrawer->SetFaceBoundaryDraw(Standard_True);
+    SetDisplayMode(0);
+}
+
+bool MergedBatch::AddPart(int geometryID, const TopoDS_Shape& shape, const gp_Trsf& trsf)
+{
+    // Count first, a part is never split between batches
+    int nbVertices = 0;
+    for (TopExp_Explorer faceIt(shape, TopAbs_FACE); faceIt.More(); faceIt.Next()) {
+        TopLoc_Location location;
+        const Handle(Poly_Triangulation)& triangulation = BRep_Tool::Triangulation(TopoDS::Face(faceIt.Current()), location);
+        if (!triangulation.IsNull()) nbVertices += triangulation->NbNodes();
+    }
+    if (!m_Parts.empty() && m_NbVertices + nbVertices > s_MaxVertices) return false;
+
+    const bool hasNormals = m_Format != VertexFormat::NoNormals;
+
+    Part part { geometryID, static_cast<int>(m_NbIndices), 0, static_cast<int>(m_NbVertices), nbVertices };
+    for (TopExp_Explorer faceIt(shape, TopAbs_FACE); faceIt.More(); faceIt.Next()) {
+        const TopoDS_Face& face = TopoDS::Face(faceIt.Current());
+        TopLoc_Location location;
+        const Handle(Poly_Triangulation)& triangulation = BRep_Tool::Triangulation(face, location);
+        if (triangulation.IsNull()) continue;
+
+        if (hasNormals && !triangulation->HasNormals()) StdPrs_ToolTriangulatedShape::ComputeNormals(face, triangulation);
+        const gp_Trsf faceTrsf = trsf * location.Transformation();
+        const bool isReversed = face.Orientation() == TopAbs_REVERSED;
+        const bool isMirrored = faceTrsf.IsNegative();  // Transformed() mirrors normals, the winding flips
+        const int firstVertex = static_cast<int>(m_NbVertices);
+
+        for (int i = 1; i <= triangulation->NbNodes(); ++i) {
+            const gp_Pnt point = triangulation->Node(i).Transformed(faceTrsf);
+            m_Positions.insert(m_Positions.end(), { float(point.X()), float(point.Y()), float(point.Z()) });
+            if (hasNormals) {
+                gp_Dir normal = triangulation->Normal(i).Transformed(faceTrsf);
+                if (isReversed) normal.Reverse();
+                m_Normals.insert(m_Normals.end(), { float(normal.X()), float(normal.Y()), float(normal.Z()) });
+            }
+        }
+        for (int i = 1; i <= triangulation->NbTriangles(); ++i) {
+            int n1, n2, n3;
+            triangulation->Triangle(i).Get(n1, n2, n3);
+            if (isReversed != isMirrored) std::swap(n2, n3);
+            m_Indices.insert(m_Indices.end(), { firstVertex + n1 - 1, firstVertex + n2 - 1, firstVertex + n3 - 1 });
+        }
+        m_NbVertices += triangulation->NbNodes();
+        m_NbIndices += 3 * triangulation->NbTriangles();
+    }
+    part.NbIndices = static_cast<int>(m_NbIndices) - part.FirstIndex;
+    m_Parts.push_back(part);
+    AddBoundaries(shape, trsf);
+    return true;
+}
+
+void MergedBatch::AddBoundaries(const TopoDS_Shape& shape, const gp_Trsf& trsf)
+{
+    // Each edge once, from the triangulation of its first face (as StdPrs_ShadedShape::FillFaceBoundaries() does)
+    TopTools_IndexedDataMapOfShapeListOfShape edgeFaces;
+    TopExp::MapShapesAndAncestors(shape, TopAbs_EDGE, TopAbs_FACE, edgeFaces);
+    for (int i = 1; i <= edgeFaces.Extent(); ++i) {
+        const TopoDS_Edge& edge = TopoDS::Edge(edgeFaces.FindKey(i));
+        const TopTools_ListOfShape& faces = edgeFaces.FindFromIndex(i);
+        if (faces.IsEmpty() || BRep_Tool::Degenerated(edge)) continue;
+
+        const TopoDS_Face& face = TopoDS::Face(faces.First());
+        if (BRep_Tool::IsClosed(edge, face)) continue;  // Seam
+        if (faces.Extent() > 1 && BRep_Tool::Continuity(edge, face, TopoDS::Face(faces.Last())) > myDrawer->FaceBoundaryUpperContinuity()) {
+            continue;  // Smooth edge
+        }
+
+        TopLoc_Location location;
+        const Handle(Poly_Triangulation)& triangulation = BRep_Tool::Triangulation(face, location);
+        if (triangulation.IsNull()) continue;
+        const Handle(Poly_PolygonOnTriangulation)& polygon = BRep_Tool::PolygonOnTriangulation(edge, triangulation, location);
+        if (polygon.IsNull()) continue;
+
+        const gp_Trsf edgeTrsf = trsf * location.Transformation();
+        const TColStd_Array1OfInteger& nodes = polygon->Nodes();
+        const int firstVertex = static_cast<int>(m_NbBoundaryVertices);
+        for (int j = nodes.Lower(); j <= nodes.Upper(); ++j) {
+            const gp_Pnt point = triangulation->Node(nodes(j)).Transformed(edgeTrsf);
+            m_BoundaryPositions.insert(m_BoundaryPositions.end(), { float(point.X()), float(point.Y()), float(point.Z()) });
+        }
+        for (int j = 0; j + 1 < nodes.Length(); ++j) {
+            m_BoundaryIndices.insert(m_BoundaryIndices.end(), { firstVertex + j, firstVertex + j + 1 });
+        }
+        m_NbBoundaryVertices += nodes.Length();
+        m_NbBoundaryIndices += 2 * (nodes.Length() - 1);
+    }
+}
+
+bool MergedBatch::IsPlanar(const TopoDS_Shape& shape)
+{
+    for (TopExp_Explorer faceIt(shape, TopAbs_FACE); faceIt.More(); faceIt.Next()) {
+        if (BRepAdaptor_Surface(TopoDS::Face(faceIt.Current()), Standard_False).GetType() != GeomAbs_Plane) return false;
+    }
+    return true;
+}
+
+void MergedBatch::Build()
+{
+    const bool hasNormals = m_Format != VertexFormat::NoNormals;
+    m_Triangles = new Graphic3d_ArrayOfTriangles(static_cast<int>(m_NbVertices), static_cast<int>(m_NbIndices),
+                                                 hasNormals ? Graphic3d_ArrayFlags_VertexNormal : Graphic3d_ArrayFlags_None);
+    for (size_t i = 0; i < m_NbVertices; ++i) {
+        const float* position = &m_Positions[3 * i];
+        if (hasNormals) {
+            const float* normal = &m_Normals[3 * i];
+            m_Triangles->AddVertex(gp_Pnt(position[0], position[1], position[2]), gp_Dir(normal[0], normal[1], normal[2]));
+        }
+        else {
+            m_Triangles->AddVertex(position[0], position[1], position[2]);
+        }
+    }
+    for (size_t i = 0; i < m_NbIndices; i += 3) {
+        m_Triangles->AddEdges(m_Indices[i] + 1, m_Indices[i + 1] + 1, m_Indices[i + 2] + 1);
+    }
+
+    if (m_NbBoundaryIndices != 0) {
+        m_Boundaries = new Graphic3d_ArrayOfSegments(static_cast<int>(m_NbBoundaryVertices), static_cast<int>(m_NbBoundaryIndices));
+        for (size_t i = 0; i < m_NbBoundaryVertices; ++i) {
+            const float* position = &m_BoundaryPositions[3 * i];
+            m_Boundaries->AddVertex(position[0], position[1], position[2]);
+        }
+        for (size_t i = 0; i < m_NbBoundaryIndices; i += 2) {
+            m_Boundaries->AddEdges(m_BoundaryIndices[i] + 1, m_BoundaryIndices[i + 1] + 1);
+        }
+    }
+
+    m_Positions = {};
+    m_Normals = {};
+    m_Indices = {};
+    m_BoundaryPositions = {};
+    m_BoundaryIndices = {};
+}
+
+size_t MergedBatch::GetBufferBytes() const
+{
+    size_t bytes = 0;
+    for (const Graphic3d_ArrayOfPrimitives* array : { static_cast<const Graphic3d_ArrayOfPrimitives*>(m_Triangles.get()),
+                                                       static_cast<const Graphic3d_ArrayOfPrimitives*>(m_Boundaries.get()) }) {
+        if (array == nullptr) continue;
+        bytes += array->Attributes()->Size();
+        if (!array->Indices().IsNull()) bytes += array->Indices()->Size();
+    }
+    return bytes;
+}
+
+void MergedBatch::Compute(const Handle(PrsMgr_PresentationManager)& prsMgr, const Handle(Prs3d_Presentation)& prs,
+                          const Standard_Integer mode)
+{
+    if (mode != 0 || m_Triangles.IsNull()) return;
+
+    Handle(Graphic3d_Group) group = prs->NewGroup();
+    group->SetGroupPrimitivesAspect(myDrawer->ShadingAspect()->Aspect());
+    group->AddPrimitiveArray(m_Triangles);
+
+    if (!m_Boundaries.IsNull() && myDrawer->FaceBoundaryDraw()) {
+        Handle(Graphic3d_Group) boundaryGroup = prs->NewGroup();
+        boundaryGroup->SetGroupPrimitivesAspect(myDrawer->FaceBoundaryAspect()->Aspect());
+        boundaryGroup->AddPrimitiveArray(m_Boundaries);
+    }
+}
+
+void MergedBatch::ComputeSelection(const Handle(SelectMgr_Selection)& selection, const Standard_Integer mode)
+{
+    if (mode != 0 || m_Triangles.IsNull()) return;
+
+    // Every part shares the batch buffers and only narrows the index range
+    for (size_t i = 0; i < m_Parts.size(); ++i) {
+        const Part& part = m_Parts[i];
+        if (part.NbIndices == 0) continue;
+
+        Handle(MergedPartOwner) owner = new MergedPartOwner(this, part.GeometryID, static_cast<int>(i));
+        Handle(Select3D_SensitivePrimitiveArray) sensitive = new Select3D_SensitivePrimitiveArray(owner);
+        if (sensitive->InitTriangulation(m_Triangles->Attributes(), m_Triangles->Indices(), TopLoc_Location(),
+                                         part.FirstIndex, part.FirstIndex + part.NbIndices - 1)) {
+            selection->Add(sensitive);
+        }
+    }
+}
+
+void MergedBatch::AddPartsGroup(const Handle(Prs3d_Presentation)& prs, const Handle(Prs3d_Drawer)& style, const std::vector<int>& partIndices) const
+{
+    int nbVertices = 0;
+    int nbIndices = 0;
+    for (int partIndex : partIndices) {
+        nbVertices += m_Parts[partIndex].NbVertices;
+        nbIndices += m_Parts[partIndex].NbIndices;
+    }
+    if (nbIndices == 0) return;
+
+    const bool hasNormals = m_Triangles->HasVertexNormals();
+    Handle(Graphic3d_ArrayOfTriangles) triangles = new Graphic3d_ArrayOfTriangles(nbVertices, nbIndices,
+                                                                                  hasNormals ? Graphic3d_ArrayFlags_VertexNormal : Graphic3d_ArrayFlags_None);
+    for (int partIndex : partIndices) {
+        const Part& part = m_Parts[partIndex];
+        const int offset = triangles->VertexNumber() - part.FirstVertex;  // Vertices are renumbered from the batch
+        for (int i = 0; i < part.NbVertices; ++i) {
+            const int vertex = part.FirstVertex + i + 1;
+            if (hasNormals) {
+                triangles->AddVertex(m_Triangles->Vertice(vertex), m_Triangles->VertexNormal(vertex));
+            }
+            else {
+                triangles->AddVertex(m_Triangles->Vertice(vertex));
+            }
+        }
+        for (int i = 0; i < part.NbIndices; i += 3) {
+            const int first = part.FirstIndex + i + 1;
+            triangles->AddEdges(m_Triangles->Edge(first) + offset, m_Triangles->Edge(first + 1) + offset, m_Triangles->Edge(first + 2) + offset);
+        }
+    }
+
+    Handle(Graphic3d_AspectFillArea3d) aspect = new Graphic3d_AspectFillArea3d(*myDrawer->ShadingAspect()->Aspect());
+    aspect->SetInteriorColor(Quantity_ColorRGBA(style->Color(), 1.0f - style->Transparency()));
+    Handle(Graphic3d_Group) group = prs->NewGroup();
+    group->SetGroupPrimitivesAspect(aspect);
+    group->AddPrimitiveArray(triangles);
+}
+
+void MergedBatch::HilightSelected(const Handle(PrsMgr_PresentationManager)& prsMgr, const SelectMgr_SequenceOfOwner& owners)
+{
+    std::vector<int> partIndices;
+    for (SelectMgr_SequenceOfOwner::Iterator ownerIt(owners); ownerIt.More(); ownerIt.Next()) {
+        if (Handle(MergedPartOwner) owner = Handle(MergedPartOwner)::DownCast(ownerIt.Value())) {
+            partIndices.push_back(owner->GetPartIndex());
+        }
+    }
+
+    Handle(Prs3d_Presentation) prs = GetSelectPresentation(prsMgr);
+    prs->Clear();
+    const Handle(Prs3d_Drawer)& style = InteractiveContext()->HighlightStyle(Prs3d_TypeOfHighlight_Selected);
+    AddPartsGroup(prs, style, partIndices);
+    prs->SetZLayer(style->ZLayer() != Graphic3d_ZLayerId_UNKNOWN ? style->ZLayer() : ZLayer());
+    prs->Display();
+}
+
+void MergedBatch::HilightOwnerWithColor(const Handle(PrsMgr_PresentationManager)& prsMgr, const Handle(Prs3d_Drawer)& style,
+                                        const Handle(SelectMgr_EntityOwner)& owner)
+{
+    Handle(MergedPartOwner) partOwner = Handle(MergedPartOwner)::DownCast(owner);
+    if (partOwner.IsNull()) return;
+
+    Handle(Prs3d_Presentation) prs = GetHilightPresentation(prsMgr);
+    prs->Clear();
+    AddPartsGroup(prs, style, { partOwner->GetPartIndex() });
+    prs->SetZLayer(style->ZLayer() != Graphic3d_ZLayerId_UNKNOWN ? style->ZLayer() : ZLayer());
+    if (prsMgr->IsImmediateModeOn()) {
+        prsMgr->AddToImmediateList(prs);  // Hover highlight, drawn over the cached scene
+    }
+    else {
+        prs->Display();
+    }
+}
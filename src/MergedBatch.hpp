@@ -0,0 +1,110 @@
+#pragma once
+
+#include <AIS_InteractiveObject.hxx>
+#include <Graphic3d_ArrayOfSegments.hxx>
+#include <Graphic3d_ArrayOfTriangles.hxx>
+#include <SelectMgr_EntityOwner.hxx>
+#include <TopoDS_Shape.hxx>
+#include <gp_Trsf.hxx>
+
+#include <vector>
+
+
+// Picked part of a MergedBatch, resolves to the geometry whose triangles were hit
+class MergedPartOwner : public SelectMgr_EntityOwner
+{
+public:
+    DEFINE_STANDARD_RTTI_INLINE(MergedPartOwner, SelectMgr_EntityOwner)
+
+    MergedPartOwner(const Handle(SelectMgr_SelectableObject)& batch, int geometryID, int partIndex)
+        : SelectMgr_EntityOwner(batch), m_GeometryID(geometryID), m_PartIndex(partIndex) {}
+
+    int GetGeometryID() const { return m_GeometryID; }
+    int GetPartIndex() const { return m_PartIndex; }
+
+    // The batch highlights the part's triangles only, see MergedBatch::HilightOwnerWithColor()
+    Standard_Boolean IsAutoHilight() const override { return Standard_False; }
+
+private:
+    int m_GeometryID;
+    int m_PartIndex;
+};
+
+// Static parts of one color packed into a single vertex/index buffer, drawn with one draw call.
+// Face boundaries of all parts are packed the same way into one segment array, a second draw call.
+// Parts keep their index range in the buffer, so picking and highlighting still resolve to single geometries.
+// Triangles are stored in world coordinates: the batch must be rebuilt when a part moves, shows or hides.
+class MergedBatch : public AIS_InteractiveObject
+{
+public:
+    DEFINE_STANDARD_RTTI_INLINE(MergedBatch, AIS_InteractiveObject)
+
+    struct Part
+    {
+        int GeometryID;
+        int FirstIndex;  // In the index buffer
+        int NbIndices;
+        int FirstVertex;
+        int NbVertices;
+    };
+
+    // Float positions either way, the built-in OCCT shaders do not read quantized attributes
+    enum class VertexFormat
+    {
+        Standard,     // Float positions and normals
+        NoNormals     // Float positions only, shaded per triangle (for parts made of planar faces)
+    };
+
+    explicit MergedBatch(const Quantity_Color& color, VertexFormat format = VertexFormat::Standard);
+
+    // True if every face of shape is planar, it can then go to a VertexFormat::NoNormals batch
+    static bool IsPlanar(const TopoDS_Shape& shape);
+
+    // Appends the face triangulations and face boundaries of shape placed by trsf, faces without triangulation are skipped.
+    // Returns false once the batch is full (nothing is appended then).
+    bool AddPart(int geometryID, const TopoDS_Shape& shape, const gp_Trsf& trsf);
+    // Uploads the collected triangles, the batch can be displayed afterwards
+    void Build();
+
+    const std::vector<Part>& GetParts() const { return m_Parts; }
+    size_t GetNbVertices() const { return m_NbVertices; }
+    size_t GetNbTriangles() const { return m_NbIndices / 3; }
+    size_t GetNbBoundarySegments() const { return m_NbBoundaryIndices / 2; }
+    VertexFormat GetVertexFormat() const { return m_Format; }
+    // Vertex and index buffers of the built arrays, as uploaded to the GPU
+    size_t GetBufferBytes() const;
+
+    static constexpr size_t s_MaxVertices = 1 << 20;  // Keeps single uploads and selection BVH builds bounded
+
+    Standard_Boolean AcceptDisplayMode(const Standard_Integer mode) const override { return mode == 0; }
+
+    void HilightSelected(const Handle(PrsMgr_PresentationManager)& prsMgr, const SelectMgr_SequenceOfOwner& owners) override;
+    void HilightOwnerWithColor(const Handle(PrsMgr_PresentationManager)& prsMgr, const Handle(Prs3d_Drawer)& style,
+                               const Handle(SelectMgr_EntityOwner)& owner) override;
+
+protected:
+    void Compute(const Handle(PrsMgr_PresentationManager)& prsMgr, const Handle(Prs3d_Presentation)& prs,
+                 const Standard_Integer mode) override;
+    void ComputeSelection(const Handle(SelectMgr_Selection)& selection, const Standard_Integer mode) override;
+
+private:
+    VertexFormat m_Format;
+    std::vector<Part> m_Parts;
+    // Collected until Build(), which copies them into m_Triangles
+    std::vector<float> m_Positions;
+    std::vector<float> m_Normals;
+    std::vector<int> m_Indices;
+    size_t m_NbVertices { 0 };
+    size_t m_NbIndices { 0 };
+    std::vector<float> m_BoundaryPositions;
+    std::vector<int> m_BoundaryIndices;  // Segment end points
+    size_t m_NbBoundaryVertices { 0 };
+    size_t m_NbBoundaryIndices { 0 };
+    Handle(Graphic3d_ArrayOfTriangles) m_Triangles;
+    Handle(Graphic3d_ArrayOfSegments) m_Boundaries;  // Built once, shared by every computed presentation
+
+    void AddBoundaries(const TopoDS_Shape& shape, const gp_Trsf& trsf);
+
+    // One group with the triangles of parts, shaded with the color of style
+    void AddPartsGroup(const Handle(Prs3d_Presentation)& prs, const Handle(Prs3d_Drawer)& style, const std::vector<int>& partIndices) const;
+};
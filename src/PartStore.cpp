@@ -0,0 +1,87 @@
+#include "PartStore.hpp"
+#include "Trace.hpp"
+
+#include <BinTools.hxx>
+#include <Message.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+
+bool PartStore::Open(const std::string& directory)
+{
+    Close();
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        Message::DefaultMessenger()->Send(("Cannot create part store " + directory + ": " + error.message()).c_str(), Message_Warning);
+        return false;
+    }
+    m_Directory = directory;
+    return true;
+}
+
+void PartStore::Close()
+{
+    Clear();
+    m_Directory.clear();
+}
+
+bool PartStore::Store(int partID, const TopoDS_Shape& shape)
+{
+    if (!IsOpen() || Contains(partID)) return IsOpen();
+
+    TRACE_SCOPE("PartStore::Store");
+    std::ofstream stream(GetBlobPath(partID), std::ios::binary | std::ios::trunc);
+    BinTools::Write(shape, stream, Standard_True, Standard_False, BinTools_FormatVersion_CURRENT);
+    if (!stream) {
+        Message::DefaultMessenger()->Send("Cannot write part to the store", Message_Warning);
+        return false;
+    }
+
+    const size_t bytes = static_cast<size_t>(stream.tellp());
+    m_BlobSizes[partID] = bytes;
+    ++m_Stats.StoredCount;
+    m_Stats.StoredBytes += bytes;
+    return true;
+}
+
+TopoDS_Shape PartStore::Load(int partID)
+{
+    TopoDS_Shape shape;
+    if (!Contains(partID)) return shape;
+
+    TRACE_SCOPE("PartStore::Load");
+    const auto start = std::chrono::steady_clock::now();
+    std::ifstream stream(GetBlobPath(partID), std::ios::binary);
+    BinTools::Read(shape, stream);
+    if (!stream && !stream.eof()) {
+        Message::DefaultMessenger()->Send("Cannot read part from the store", Message_Warning);
+        return TopoDS_Shape();
+    }
+
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    ++m_Stats.LoadCount;
+    m_Stats.TotalLoadMs += ms;
+    m_Stats.MaxLoadMs = std::max(m_Stats.MaxLoadMs, ms);
+    m_Stats.LastLoadMs = ms;
+    return shape;
+}
+
+void PartStore::Clear()
+{
+    for (const auto& blob : m_BlobSizes) {
+        std::error_code error;
+        std::filesystem::remove(GetBlobPath(blob.first), error);
+    }
+    m_BlobSizes.clear();
+    m_Stats = { 0, 0, 0, 0.0, 0.0, 0.0 };
+}
+
+std::string PartStore::GetBlobPath(int partID) const
+{
+    return m_Directory + "/" + std::to_string(partID) + ".bin";
+}
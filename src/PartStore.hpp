@@ -0,0 +1,46 @@
+#pragma once
+
+#include <TopoDS_Shape.hxx>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+
+// Backing store for the B-Rep and triangulation of parts evicted from memory.
+// Each part is one BinTools blob in a directory: on MEMFS in the browser (outside wasm memory), a regular directory natively.
+// Blobs are keyed by part ID and removed when a new model is loaded, the store does not outlive the session.
+class PartStore
+{
+public:
+    struct Stats
+    {
+        size_t StoredCount;
+        size_t StoredBytes;  // Total blob size
+        size_t LoadCount;
+        double TotalLoadMs;
+        double MaxLoadMs;
+        double LastLoadMs;
+    };
+
+    // Creates directory if needed
+    bool Open(const std::string& directory);
+    void Close();  // Removes the blobs written
+    bool IsOpen() const { return !m_Directory.empty(); }
+
+    // Writes shape with its triangulation once, later calls for the same part are no-ops
+    bool Store(int partID, const TopoDS_Shape& shape);
+    bool Contains(int partID) const { return m_BlobSizes.count(partID) != 0; }
+    // Returns a null shape if the part is not stored or its blob cannot be read
+    TopoDS_Shape Load(int partID);
+
+    void Clear();  // Removes all blobs, the store stays open
+    const Stats& GetStats() const { return m_Stats; }
+
+private:
+    std::string m_Directory;
+    std::unordered_map<int, size_t> m_BlobSizes;
+    Stats m_Stats { 0, 0, 0, 0.0, 0.0, 0.0 };
+
+    std::string GetBlobPath(int partID) const;
+};
@@ -0,0 +1,135 @@
+#include "PerfOverlay.hpp"
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+
+
+namespace
+{
+    const char* const s_PhaseNames[] = { "Input flush", "3D redraw", "ImGui build", "ImGui render" };
+}
+
+void PerfOverlay::BeginFrame()
+{
+    std::fill(std::begin(m_CurrentPhases), std::end(m_CurrentPhases), 0.0f);
+    m_PrevFrameBeginMs = m_FrameBeginMs;
+    m_FrameBeginMs = NowMs();
+    m_CurrentRedrawKind = RedrawKind::Full;
+    m_bInFrame = true;
+}
+
+void PerfOverlay::EndFrame()
+{
+    if (!m_bInFrame) return;
+    m_bInFrame = false;
+
+    for (int phase = 0; phase < s_PhaseCount; ++phase) {
+        m_PhaseHistory[phase][m_HistoryHead] = m_CurrentPhases[phase];
+    }
+    m_FrameHistory[m_HistoryHead] = static_cast<float>(NowMs() - m_FrameBeginMs);
+    m_IntervalHistory[m_HistoryHead] = m_PrevFrameBeginMs > 0.0 ? static_cast<float>(m_FrameBeginMs - m_PrevFrameBeginMs) : 0.0f;
+    m_RedrawKindHistory[m_HistoryHead] = m_CurrentRedrawKind;
+    m_HistoryHead = (m_HistoryHead + 1) % s_HistorySize;
+    m_HistoryCount = std::min(m_HistoryCount + 1, s_HistorySize);
+    ++m_FramesSincePercentiles;
+}
+
+void PerfOverlay::SetFrameStats(size_t drawCalls, size_t triangles, size_t structures)
+{
+    m_DrawCalls = drawCalls;
+    m_Triangles = triangles;
+    m_Structures = structures;
+}
+
+void PerfOverlay::UpdatePercentiles()
+{
+    m_FramesSincePercentiles = 0;
+    if (m_HistoryCount == 0) return;
+
+    float sorted[s_HistorySize];
+    std::copy(m_FrameHistory, m_FrameHistory + m_HistoryCount, sorted);  // Order is irrelevant for percentiles
+    std::sort(sorted, sorted + m_HistoryCount);
+
+    const float ratios[3] = { 0.50f, 0.95f, 0.99f };
+    for (int i = 0; i < 3; ++i) {
+        const int index = std::min(m_HistoryCount - 1, static_cast<int>(ratios[i] * m_HistoryCount));
+        m_Percentiles[i] = sorted[index];
+    }
+
+    const float* redrawTimes = m_PhaseHistory[static_cast<int>(FramePhase::Redraw3D)];
+    float redrawSums[s_RedrawKindCount] {};
+    std::fill(std::begin(m_RedrawCounts), std::end(m_RedrawCounts), 0);
+    for (int i = 0; i < m_HistoryCount; ++i) {
+        const int kind = static_cast<int>(m_RedrawKindHistory[i]);
+        ++m_RedrawCounts[kind];
+        redrawSums[kind] += redrawTimes[i];
+    }
+    for (int kind = 0; kind < s_RedrawKindCount; ++kind) {
+        m_RedrawMeanMs[kind] = m_RedrawCounts[kind] > 0 ? redrawSums[kind] / m_RedrawCounts[kind] : 0.0f;
+    }
+
+    double intervalSum = 0.0;
+    double intervalSquareSum = 0.0;
+    int intervalCount = 0;
+    for (int i = 0; i < m_HistoryCount; ++i) {
+        const float interval = m_IntervalHistory[i];
+        if (interval <= 0.0f || interval > s_IdleGapMs) continue;
+        intervalSum += interval;
+        intervalSquareSum += static_cast<double>(interval) * interval;
+        ++intervalCount;
+    }
+    if (intervalCount > 0) {
+        const double mean = intervalSum / intervalCount;
+        m_MeanIntervalMs = static_cast<float>(mean);
+        m_JitterMs = static_cast<float>(std::sqrt(std::max(0.0, intervalSquareSum / intervalCount - mean * mean)));
+    }
+}
+
+void PerfOverlay::GetFrameIntervals(double& meanMs, double& jitterMs)
+{
+    UpdatePercentiles();
+    meanMs = m_MeanIntervalMs;
+    jitterMs = m_JitterMs;
+}
+
+void PerfOverlay::Draw()
+{
+    if (!m_bVisible) return;
+
+    if (m_FramesSincePercentiles >= s_PercentileInterval) {
+        UpdatePercentiles();
+    }
+
+    ImGui::SetNextWindowSize(ImVec2(360.0f, 0.0f), ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("Performance", &m_bVisible)) {
+        ImGui::Text("Frame  p50 %.2f ms  p95 %.2f ms  p99 %.2f ms", m_Percentiles[0], m_Percentiles[1], m_Percentiles[2]);
+        ImGui::Text("Frame interval %.2f ms  jitter %.2f ms", m_MeanIntervalMs, m_JitterMs);
+        ImGui::Text("Pending update requests: %u", m_PendingUpdates);
+        ImGui::Text("Render scale: %.3f  (%zu changes)", m_RenderScale, m_RenderScaleChanges);
+        ImGui::Text("Interaction LOD  boxes %zu  lowered %zu", m_LodProxyCount, m_LodLoweredCount);
+        ImGui::Text("Draw calls: %zu  Triangles: %zu  Structures: %zu", m_DrawCalls, m_Triangles, m_Structures);
+        ImGui::Text("Culled structures: %zu of %zu", m_CulledStructures, m_TotalStructures);
+        ImGui::Text("3D redraws  full %d (%.2f ms)  immediate %d (%.2f ms)  cached %d (%.2f ms)",
+                    m_RedrawCounts[static_cast<int>(RedrawKind::Full)], m_RedrawMeanMs[static_cast<int>(RedrawKind::Full)],
+                    m_RedrawCounts[static_cast<int>(RedrawKind::Immediate)], m_RedrawMeanMs[static_cast<int>(RedrawKind::Immediate)],
+                    m_RedrawCounts[static_cast<int>(RedrawKind::Cached)], m_RedrawMeanMs[static_cast<int>(RedrawKind::Cached)]);
+        ImGui::Separator();
+
+        // The ring buffer is plotted from its oldest sample through the offset argument
+        const int offset = m_HistoryCount < s_HistorySize ? 0 : m_HistoryHead;
+        for (int phase = 0; phase < s_PhaseCount; ++phase) {
+            const float latest = m_PhaseHistory[phase][(m_HistoryHead + s_HistorySize - 1) % s_HistorySize];
+            char overlay[32];
+            snprintf(overlay, sizeof(overlay), "%.2f ms", latest);
+            ImGui::PlotHistogram(s_PhaseNames[phase], m_PhaseHistory[phase], m_HistoryCount, offset,
+                                 overlay, 0.0f, FLT_MAX, ImVec2(0.0f, 40.0f));
+        }
+        ImGui::PlotLines("Frame", m_FrameHistory, m_HistoryCount, offset, nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, 40.0f));
+    }
+    ImGui::End();
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+
+enum class FramePhase
+{
+    InputFlush,   // FlushViewEvents without the 3D redraw
+    Redraw3D,     // V3d_View redraw inside handleViewRedraw
+    ImGuiBuild,   // NewFrame up to ImGui::Render
+    ImGuiRender,  // ImGui::Render and the OpenGL3 backend
+    Count
+};
+
+enum class RedrawKind
+{
+    Cached,     // UI-only frame, ImGui composed over the cached 3D image
+    Immediate,  // Main scene blitted from the OpenGl_View cache, only immediate layers (hover highlight) redrawn
+    Full,       // Whole scene rendered
+    Count
+};
+
+// ImGui panel with rolling per-phase frame timings, frame time percentiles and OCCT frame statistics.
+// Timing a frame costs a handful of clock reads, percentiles are only computed while the panel is open.
+class PerfOverlay
+{
+public:
+    static double NowMs()
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void BeginFrame();
+    void AddPhaseTime(FramePhase phase, double ms) { m_CurrentPhases[static_cast<int>(phase)] += static_cast<float>(ms); }
+    double GetPhaseTime(FramePhase phase) const { return m_CurrentPhases[static_cast<int>(phase)]; }  // In the current frame
+    void SetRedrawKind(RedrawKind kind) { m_CurrentRedrawKind = kind; }
+    void EndFrame();
+
+    void SetPendingUpdates(unsigned int count) { m_PendingUpdates = count; }
+    void SetRenderScale(float scale, size_t changeCount) { m_RenderScale = scale; m_RenderScaleChanges = changeCount; }
+    void SetInteractionLod(size_t proxyCount, size_t loweredCount) { m_LodProxyCount = proxyCount; m_LodLoweredCount = loweredCount; }
+    void SetCulledStructures(size_t culled, size_t total) { m_CulledStructures = culled; m_TotalStructures = total; }
+    void SetFrameStats(size_t drawCalls, size_t triangles, size_t structures);
+
+    bool IsVisible() const { return m_bVisible; }
+    void SetVisible(bool visible) { m_bVisible = visible; }
+    bool* GetVisiblePtr() { return &m_bVisible; }
+
+    void Draw();
+
+    // Mean and standard deviation of the frame intervals in the history, idle gaps excluded
+    void GetFrameIntervals(double& meanMs, double& jitterMs);
+
+private:
+    static constexpr int s_HistorySize = 240;
+    static constexpr int s_PhaseCount = static_cast<int>(FramePhase::Count);
+    static constexpr int s_RedrawKindCount = static_cast<int>(RedrawKind::Count);
+    static constexpr int s_PercentileInterval = 15;  // Frames between percentile updates
+    static constexpr float s_IdleGapMs = 100.0f;     // Longer frame intervals are idle periods, not pacing
+
+    float m_PhaseHistory[s_PhaseCount][s_HistorySize] {};
+    float m_FrameHistory[s_HistorySize] {};
+    float m_IntervalHistory[s_HistorySize] {};  // From the previous frame begin
+    RedrawKind m_RedrawKindHistory[s_HistorySize] {};
+    int m_HistoryHead { 0 };   // Next slot to write
+    int m_HistoryCount { 0 };
+
+    float m_CurrentPhases[s_PhaseCount] {};
+    RedrawKind m_CurrentRedrawKind { RedrawKind::Full };
+    double m_FrameBeginMs { 0.0 };
+    double m_PrevFrameBeginMs { 0.0 };
+    bool m_bInFrame { false };
+
+    float m_Percentiles[3] {};  // p50, p95, p99
+    int m_FramesSincePercentiles { s_PercentileInterval };
+    int m_RedrawCounts[s_RedrawKindCount] {};    // Frames of each kind in the history
+    float m_RedrawMeanMs[s_RedrawKindCount] {};  // Mean 3D redraw time of each kind
+    float m_MeanIntervalMs { 0.0f };
+    float m_JitterMs { 0.0f };  // Standard deviation of frame intervals
+
+    unsigned int m_PendingUpdates { 0 };
+    float m_RenderScale { 1.0f };
+    size_t m_RenderScaleChanges { 0 };
+    size_t m_LodProxyCount { 0 };
+    size_t m_LodLoweredCount { 0 };
+    size_t m_CulledStructures { 0 };
+    size_t m_TotalStructures { 0 };
+    size_t m_DrawCalls { 0 };
+    size_t m_Triangles { 0 };
+    size_t m_Structures { 0 };
+
+    bool m_bVisible { false };
+
+    void UpdatePercentiles();
+};
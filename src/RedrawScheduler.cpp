@@ -0,0 +1,80 @@
+#include "RedrawScheduler.hpp"
+
+#include <emscripten/emscripten.h>
+
+
+void RedrawScheduler::Request()
+{
+    m_FramesLeft = s_SettleFrames;
+    RequestFrame();
+}
+
+void RedrawScheduler::SetIdleMode(bool idle)
+{
+    m_bIdleMode = idle;
+    Request();  // Restarts the loop when leaving idle mode
+}
+
+void RedrawScheduler::SetPageHidden(bool hidden)
+{
+    m_bPageHidden = hidden;
+    if (!hidden) Request();  // Frames were not drawn meanwhile
+}
+
+void RedrawScheduler::SetPacing(Pacing pacing)
+{
+    m_Pacing = pacing;
+    Request();  // The pending frame, if any, still comes through the former path
+}
+
+void RedrawScheduler::RequestFrame()
+{
+    if (m_bPending || m_bPageHidden) return;
+
+    m_bPending = true;
+    if (m_Pacing == Pacing::AnimationFrame) {
+        emscripten_request_animation_frame(OnAnimationFrame, this);
+    }
+    else {
+        emscripten_async_call(OnAsyncCall, this, 0);
+    }
+}
+
+EM_BOOL RedrawScheduler::OnAnimationFrame(double timeMs, void* userData)
+{
+    static_cast<RedrawScheduler*>(userData)->OnFrame(timeMs);
+    return EM_FALSE;
+}
+
+void RedrawScheduler::OnAsyncCall(void* userData)
+{
+    static_cast<RedrawScheduler*>(userData)->OnFrame(emscripten_get_now());
+}
+
+void RedrawScheduler::OnFrame(double timeMs)
+{
+    m_bPending = false;
+    if (m_bPageHidden) return;
+
+    if (m_TargetFps > 0.0) {
+        const double intervalMs = 1000.0 / m_TargetFps;
+        if (timeMs - m_LastFrameMs < intervalMs - s_PacingToleranceMs) {
+            ++m_SkippedFrames;
+            RequestFrame();
+            return;
+        }
+        // Advance by the target interval rather than to timeMs, which would round the rate down to a divisor
+        // of the display rate (40 FPS on 60 Hz would draw every other refresh, 30 FPS)
+        m_LastFrameMs += intervalMs;
+        if (timeMs - m_LastFrameMs > intervalMs) m_LastFrameMs = timeMs;  // After a stall, no catch-up burst
+    }
+    else {
+        m_LastFrameMs = timeMs;
+    }
+    if (m_FramesLeft > 0) --m_FramesLeft;
+
+    m_Callback(m_pUserData);  // May request more frames
+    if (!m_bIdleMode || m_FramesLeft > 0) {
+        RequestFrame();
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <emscripten/html5.h>
+
+#include <cstddef>
+
+
+// Coalesces redraw requests into at most one requestAnimationFrame callback per display refresh.
+// Continuous mode keeps a frame scheduled at all times, idle mode only draws a few frames after each request
+// (ImGui needs them to settle). Nothing is scheduled while the page is hidden.
+// The former pacing, a zero-delay emscripten_async_call() after every frame, is kept to compare frame jitter.
+class RedrawScheduler
+{
+public:
+    using FrameCallback = void (*)(void* userData);
+
+    enum class Pacing
+    {
+        AnimationFrame,
+        AsyncCall  // Zero-delay timeouts, not synchronized with the display
+    };
+
+    RedrawScheduler(FrameCallback callback, void* userData) : m_Callback(callback), m_pUserData(userData) {}
+
+    void Request();
+
+    void SetTargetFps(double fps) { m_TargetFps = fps; }  // 0: display refresh rate
+    double GetTargetFps() const { return m_TargetFps; }
+    void SetIdleMode(bool idle);
+    bool IsIdleMode() const { return m_bIdleMode; }
+    void SetPageHidden(bool hidden);
+    void SetPacing(Pacing pacing);
+    Pacing GetPacing() const { return m_Pacing; }
+
+    size_t GetSkippedFrames() const { return m_SkippedFrames; }  // Animation frames dropped by the FPS target
+
+private:
+    static constexpr int s_SettleFrames = 3;
+    static constexpr double s_PacingToleranceMs = 2.0;  // So a 60 FPS target on a 60 Hz display never skips
+
+    FrameCallback m_Callback;
+    void* m_pUserData;
+    double m_TargetFps { 0.0 };
+    double m_LastFrameMs { 0.0 };
+    int m_FramesLeft { 0 };
+    size_t m_SkippedFrames { 0 };
+    bool m_bIdleMode { false };
+    bool m_bPageHidden { false };
+    bool m_bPending { false };  // A frame is requested
+    Pacing m_Pacing { Pacing::AnimationFrame };
+
+    void RequestFrame();
+    void OnFrame(double timeMs);
+    static EM_BOOL OnAnimationFrame(double timeMs, void* userData);
+    static void OnAsyncCall(void* userData);
+};
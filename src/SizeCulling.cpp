@@ -0,0 +1,75 @@
+#include "SizeCulling.hpp"
+
+#include <Graphic3d_ZLayerSettings.hxx>
+#include <Precision.hxx>
+
+#include <unordered_set>
+
+
+void SizeCulling::Init(const Handle(V3d_Viewer)& viewer)
+{
+    Graphic3d_ZLayerSettings settings;
+    settings.SetName("Size culling exempt");
+    settings.SetClearDepth(Standard_False);  // Depth tested against the default layer
+    viewer->InsertLayerAfter(m_ExemptLayer, settings, Graphic3d_ZLayerId_Default);
+}
+
+bool SizeCulling::Apply(const Handle(V3d_Viewer)& viewer)
+{
+    const double pixels = m_bEnabled && !m_bSuspended ? m_MinPixels : -1.0;
+    if (pixels == m_AppliedPixels) return false;
+
+    Graphic3d_ZLayerSettings settings = viewer->ZLayerSettings(Graphic3d_ZLayerId_Default);
+    settings.SetCullingSize(pixels > 0.0 ? pixels : Precision::Infinite());
+    viewer->SetZLayerSettings(Graphic3d_ZLayerId_Default, settings);
+    m_AppliedPixels = pixels;
+    return true;
+}
+
+void SizeCulling::SetExempt(const Handle(AIS_InteractiveContext)& context, const Handle(AIS_InteractiveObject)& object,
+                            ExemptReason reason, bool exempt)
+{
+    if (m_ExemptLayer == Graphic3d_ZLayerId_UNKNOWN) return;
+
+    if (exempt) {
+        Entry& entry = m_Exempt[object.get()];
+        if (entry.Reasons == 0) {
+            entry.Object = object;
+            context->SetZLayer(object, m_ExemptLayer);
+        }
+        entry.Reasons |= reason;
+    }
+    else {
+        auto it = m_Exempt.find(object.get());
+        if (it == m_Exempt.end()) return;
+
+        it->second.Reasons &= ~reason;
+        if (it->second.Reasons == 0) {
+            context->SetZLayer(object, Graphic3d_ZLayerId_Default);
+            m_Exempt.erase(it);
+        }
+    }
+    m_Stats.ExemptCount = m_Exempt.size();
+}
+
+void SizeCulling::ReplaceExempt(const Handle(AIS_InteractiveContext)& context, ExemptReason reason,
+                                const std::vector<Handle(AIS_InteractiveObject)>& objects)
+{
+    std::unordered_set<const AIS_InteractiveObject*> kept;
+    for (const Handle(AIS_InteractiveObject)& object : objects) kept.insert(object.get());
+
+    std::vector<Handle(AIS_InteractiveObject)> released;
+    for (const auto& exempt : m_Exempt) {
+        if ((exempt.second.Reasons & reason) != 0 && kept.count(exempt.first) == 0) released.push_back(exempt.second.Object);
+    }
+    for (const Handle(AIS_InteractiveObject)& object : released) SetExempt(context, object, reason, false);
+    for (const Handle(AIS_InteractiveObject)& object : objects) SetExempt(context, object, reason, true);
+}
+
+void SizeCulling::SetFrameStats(size_t totalStructures, size_t notCulledStructures, size_t notCulledElements)
+{
+    // Includes structures outside the view frustum, which OCCT culls regardless of the size threshold
+    m_Stats.TotalStructures = totalStructures;
+    m_Stats.CulledStructures = totalStructures > notCulledStructures ? totalStructures - notCulledStructures : 0;
+    m_Stats.ElementsNotCulled = notCulledElements;
+}
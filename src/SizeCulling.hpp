@@ -0,0 +1,71 @@
+#pragma once
+
+#include <AIS_InteractiveContext.hxx>
+#include <Graphic3d_ZLayerId.hxx>
+#include <V3d_Viewer.hxx>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+
+// Skips objects whose projected size is under MinPixels, using the size culling of the default layer
+// (Graphic3d_ZLayerSettings::SetCullingSize), so culled structures cost no draw call.
+// Exempt objects (the selection, pinned geometry) are moved to a layer rendered right after the default one
+// with the same depth buffer and no size culling.
+class SizeCulling
+{
+public:
+    enum ExemptReason : uint8_t
+    {
+        Selected = 1 << 0,
+        Pinned = 1 << 1
+    };
+
+    struct Stats
+    {
+        size_t ExemptCount;
+        size_t CulledStructures;  // Presentations skipped by culling in the last frame, with their draw calls
+        size_t TotalStructures;
+        size_t ElementsNotCulled;  // Primitive groups drawn in the last frame, one draw call each
+    };
+
+    // Creates the exempt layer, once the viewer exists
+    void Init(const Handle(V3d_Viewer)& viewer);
+
+    void SetEnabled(bool enabled) { m_bEnabled = enabled; }
+    bool IsEnabled() const { return m_bEnabled; }
+    bool* GetEnabledPtr() { return &m_bEnabled; }
+    void SetMinPixels(double pixels) { m_MinPixels = pixels; }
+    double GetMinPixels() const { return m_MinPixels; }
+    // No culling while suspended, merged batches span the whole scene and would never be culled
+    void SetSuspended(bool suspended) { m_bSuspended = suspended; }
+    bool IsSuspended() const { return m_bSuspended; }
+
+    // Pushes the threshold to the default layer when it changed, returns true if the view must be redrawn
+    bool Apply(const Handle(V3d_Viewer)& viewer);
+
+    void SetExempt(const Handle(AIS_InteractiveContext)& context, const Handle(AIS_InteractiveObject)& object,
+                   ExemptReason reason, bool exempt);
+    // Replaces the objects exempt for reason with objects
+    void ReplaceExempt(const Handle(AIS_InteractiveContext)& context, ExemptReason reason,
+                       const std::vector<Handle(AIS_InteractiveObject)>& objects);
+
+    void SetFrameStats(size_t totalStructures, size_t notCulledStructures, size_t notCulledElements);
+    const Stats& GetStats() const { return m_Stats; }
+
+private:
+    struct Entry
+    {
+        Handle(AIS_InteractiveObject) Object;
+        uint8_t Reasons { 0 };
+    };
+
+    bool m_bEnabled { false };
+    bool m_bSuspended { false };
+    double m_MinPixels { 4.0 };
+    double m_AppliedPixels { -1.0 };  // Culling size of the default layer, negative: none
+    Graphic3d_ZLayerId m_ExemptLayer { Graphic3d_ZLayerId_UNKNOWN };
+    std::unordered_map<const AIS_InteractiveObject*, Entry> m_Exempt;
+    Stats m_Stats {};
+};
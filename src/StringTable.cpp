@@ -0,0 +1,79 @@
+#include "StringTable.hpp"
+
+#include <cstring>
+
+
+StringTable& StringTable::GetInstance()
+{
+    static StringTable s_Instance;
+    return s_Instance;
+}
+
+StringTable::StringID StringTable::Intern(std::string_view str)
+{
+    auto it = m_Lookup.find(str);
+    if (it != m_Lookup.end()) {
+        return it->second;
+    }
+
+    std::string_view stored(Store(str), str.size());
+    StringID id = static_cast<StringID>(m_Strings.size());
+    m_Strings.push_back(stored);
+    m_Lookup.emplace(stored, id);
+    return id;
+}
+
+StringTable::StringID StringTable::Find(std::string_view str) const
+{
+    auto it = m_Lookup.find(str);
+    return it != m_Lookup.end() ? it->second : InvalidID;
+}
+
+std::string_view StringTable::Get(StringID id) const
+{
+    if (id >= m_Strings.size()) return std::string_view("");
+    return m_Strings[id];
+}
+
+void StringTable::Clear()
+{
+    std::unordered_map<std::string_view, StringID>().swap(m_Lookup);
+    std::vector<std::string_view>().swap(m_Strings);
+    m_Blocks.clear();
+    m_BlockUsed = s_BlockSize;
+    m_ArenaBytes = 0;
+}
+
+size_t StringTable::GetMemoryUsage() const
+{
+    size_t lookupBytes = m_Lookup.bucket_count() * sizeof(void*)
+        + m_Lookup.size() * (sizeof(std::string_view) + sizeof(StringID) + 2 * sizeof(void*));
+    return m_ArenaBytes + m_Strings.capacity() * sizeof(std::string_view) + lookupBytes;
+}
+
+const char* StringTable::Store(std::string_view str)
+{
+    const size_t size = str.size() + 1;  // Keep a null terminator so views can be passed to C APIs
+
+    if (size > s_BlockSize) {  // Oversized strings get a dedicated block, the current one stays open
+        m_Blocks.emplace_back(new char[size]);
+        m_ArenaBytes += size;
+        char* dest = m_Blocks.back().get();
+        std::memcpy(dest, str.data(), str.size());
+        dest[str.size()] = '\0';
+        if (m_Blocks.size() > 1) std::swap(m_Blocks.back(), m_Blocks[m_Blocks.size() - 2]);
+        return dest;
+    }
+
+    if (m_BlockUsed + size > s_BlockSize) {
+        m_Blocks.emplace_back(new char[s_BlockSize]);
+        m_ArenaBytes += s_BlockSize;
+        m_BlockUsed = 0;
+    }
+
+    char* dest = m_Blocks.back().get() + m_BlockUsed;
+    std::memcpy(dest, str.data(), str.size());
+    dest[str.size()] = '\0';
+    m_BlockUsed += size;
+    return dest;
+}
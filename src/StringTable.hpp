@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+// Scene-wide string interner.
+// Every distinct string is stored once in an append-only arena and identified by a stable StringID.
+// Views returned by Get() stay valid until Clear() and are always null-terminated.
+class StringTable
+{
+public:
+    using StringID = uint32_t;
+    static constexpr StringID InvalidID = UINT32_MAX;
+
+    static StringTable& GetInstance();
+
+    // Returns the ID of the string, storing it first if it has not been seen yet.
+    StringID Intern(std::string_view str);
+
+    // Returns the ID of an already interned string or InvalidID (never stores).
+    StringID Find(std::string_view str) const;
+
+    // Returns an empty view for InvalidID.
+    std::string_view Get(StringID id) const;
+    const char* GetCStr(StringID id) const { return Get(id).data(); }
+
+    // Releases every string, all previously returned IDs and views become invalid.
+    void Clear();
+
+    size_t GetCount() const { return m_Strings.size(); }
+    size_t GetMemoryUsage() const;
+
+private:
+    StringTable() = default;
+    StringTable(const StringTable& other) = delete;
+    StringTable& operator=(const StringTable& other) = delete;
+
+    const char* Store(std::string_view str);
+
+    static constexpr size_t s_BlockSize = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> m_Blocks;
+    size_t m_BlockUsed { s_BlockSize };
+    size_t m_ArenaBytes { 0 };
+
+    std::vector<std::string_view> m_Strings;  // Indexed by StringID
+    std::unordered_map<std::string_view, StringID> m_Lookup;
+};
@@ -0,0 +1,125 @@
+#include "Trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace
+{
+    constexpr size_t s_RingCapacity = 64 * 1024;  // Events per thread
+
+    struct RingBuffer
+    {
+        uint32_t ThreadID;
+        std::vector<Trace::Event> Events;
+        size_t Next { 0 };       // Slot of the next event
+        bool Wrapped { false };
+        std::mutex Mutex;        // Only contended while dumping
+    };
+
+    // Buffers are kept after their thread exits so its events still show up in the dump
+    std::mutex s_RegistryMutex;
+    std::vector<std::unique_ptr<RingBuffer>> s_Buffers;
+    std::atomic<uint32_t> s_NextThreadID { 1 };
+
+    RingBuffer& GetThreadBuffer()
+    {
+        thread_local RingBuffer* t_pBuffer = nullptr;
+        if (!t_pBuffer) {
+            std::unique_ptr<RingBuffer> buffer(new RingBuffer());
+            buffer->ThreadID = s_NextThreadID.fetch_add(1);
+            buffer->Events.resize(s_RingCapacity);
+            t_pBuffer = buffer.get();
+
+            std::lock_guard<std::mutex> lock(s_RegistryMutex);
+            s_Buffers.push_back(std::move(buffer));
+        }
+        return *t_pBuffer;
+    }
+
+    const auto s_Epoch = std::chrono::steady_clock::now();
+
+    void WriteJsonString(std::ostream& os, const char* str)
+    {
+        os << '"';
+        for (; *str; ++str) {
+            if (*str == '"' || *str == '\\') os << '\\';
+            os << *str;
+        }
+        os << '"';
+    }
+}
+
+uint64_t Trace::NowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s_Epoch).count();
+}
+
+void Trace::Record(const char* name, uint64_t beginUs, uint64_t endUs)
+{
+    RingBuffer& buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.Mutex);
+    buffer.Events[buffer.Next] = { name, beginUs, endUs - beginUs };
+    if (++buffer.Next == buffer.Events.size()) {
+        buffer.Next = 0;
+        buffer.Wrapped = true;
+    }
+}
+
+void Trace::WriteChromeJson(std::ostream& os)
+{
+    std::lock_guard<std::mutex> registryLock(s_RegistryMutex);
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const std::unique_ptr<RingBuffer>& buffer : s_Buffers) {
+        std::lock_guard<std::mutex> lock(buffer->Mutex);
+
+        // Oldest first: after a wrap the oldest event sits at Next
+        const size_t count = buffer->Wrapped ? buffer->Events.size() : buffer->Next;
+        const size_t start = buffer->Wrapped ? buffer->Next : 0;
+        for (size_t i = 0; i < count; ++i) {
+            const Event& event = buffer->Events[(start + i) % buffer->Events.size()];
+            os << (first ? "\n" : ",\n") << "{\"name\":";
+            WriteJsonString(os, event.Name);
+            os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->ThreadID
+               << ",\"ts\":" << event.BeginUs << ",\"dur\":" << event.DurationUs << '}';
+            first = false;
+        }
+    }
+    os << "\n]}\n";
+}
+
+bool Trace::WriteChromeJson(const char* fileName)
+{
+    std::ofstream file(fileName);
+    if (!file) return false;
+    WriteChromeJson(file);
+    return static_cast<bool>(file);
+}
+
+void Trace::Clear()
+{
+    std::lock_guard<std::mutex> registryLock(s_RegistryMutex);
+    for (const std::unique_ptr<RingBuffer>& buffer : s_Buffers) {
+        std::lock_guard<std::mutex> lock(buffer->Mutex);
+        buffer->Next = 0;
+        buffer->Wrapped = false;
+    }
+}
+
+size_t Trace::GetEventCount()
+{
+    std::lock_guard<std::mutex> registryLock(s_RegistryMutex);
+    size_t count = 0;
+    for (const std::unique_ptr<RingBuffer>& buffer : s_Buffers) {
+        std::lock_guard<std::mutex> lock(buffer->Mutex);
+        count += buffer->Wrapped ? buffer->Events.size() : buffer->Next;
+    }
+    return count;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+
+
+// Lightweight scoped tracing in Chrome trace event format (chrome://tracing, ui.perfetto.dev).
+// Each thread records complete events into its own fixed size ring buffer, the oldest events are overwritten.
+// Build with ENABLE_TRACE=OFF to compile every TRACE_* macro away.
+//
+//   void Foo() { TRACE_FUNCTION(); ... { TRACE_SCOPE("Foo::Inner"); ... } }
+namespace Trace
+{
+    struct Event
+    {
+        const char* Name;  // Must outlive the trace, use string literals
+        uint64_t BeginUs;
+        uint64_t DurationUs;
+    };
+
+    uint64_t NowUs();
+    void Record(const char* name, uint64_t beginUs, uint64_t endUs);
+
+    // Writes all buffered events of all threads as {"traceEvents": [...]}
+    void WriteChromeJson(std::ostream& os);
+    bool WriteChromeJson(const char* fileName);
+    void Clear();
+
+    size_t GetEventCount();
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char* name) : m_Name(name), m_BeginUs(NowUs()) {}
+        ~Scope() { Record(m_Name, m_BeginUs, NowUs()); }
+
+        Scope(const Scope& other) = delete;
+        Scope& operator=(const Scope& other) = delete;
+
+    private:
+        const char* m_Name;
+        uint64_t m_BeginUs;
+    };
+}
+
+#if defined(ENABLE_TRACE)
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+#define TRACE_SCOPE(name) Trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define TRACE_FUNCTION() TRACE_SCOPE(__func__)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_FUNCTION() ((void)0)
+#endif
@@ -37,6 +37,9 @@
 //#include <Wasm_Window.hxx>
 #include "GlfwOcctWindow.hpp"
 #include <OpenGl_Context.hxx>
+#include <OpenGl_FrameBuffer.hxx>
+#include <OpenGl_FrameStats.hxx>
+#include <OpenGl_Group.hxx>
 
 #include <BRep_Builder.hxx>
 #include <BRepBndLib.hxx>
@@ -45,7 +48,11 @@
 
 #include <emscripten/bind.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <sstream>
+#include <vector>
 
 #include <STEPControl_Reader.hxx>
 #include <TDocStd_Document.hxx>
@@ -58,6 +65,10 @@
 #include <BRepPrimAPI_MakeCone.hxx>
 
 #include "AppManager.hpp"
+#include "MergedBatch.hpp"
+#include "DisplaySink.hpp"
+#include "GeometryManager.hpp"
+#include "Trace.hpp"
 
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
@@ -66,6 +77,91 @@
 
 namespace
 {
+  //! Display sink forwarding geometry display and selection to the viewer interactive context.
+  class ContextDisplaySink : public DisplaySink
+  {
+  public:
+    ContextDisplaySink (WasmOcctView& theViewer) : myViewer (theViewer) {}
+
+    virtual void Display (const Handle(AIS_InteractiveObject)& theObject) override
+    {
+      myViewer.Context()->Display (theObject, false);
+    }
+
+    virtual void Erase (const Handle(AIS_InteractiveObject)& theObject) override
+    {
+      myViewer.Context()->Erase (theObject, false);
+    }
+
+    virtual void ReleaseResources (const Handle(AIS_InteractiveObject)& theObject) override
+    {
+      // Remove() clears the presentations and selections that Erase() keeps for a quick redisplay
+      myViewer.Context()->Remove (theObject, false);
+    }
+
+    virtual void SetLocation (const Handle(AIS_InteractiveObject)& theObject,
+                              const TopLoc_Location& theLoc) override
+    {
+      myViewer.Context()->SetLocation (theObject, theLoc);
+    }
+
+    virtual void SetSelectionMode (const Handle(AIS_InteractiveObject)& theObject,
+                                   TopAbs_ShapeEnum theOldMode,
+                                   TopAbs_ShapeEnum theNewMode) override
+    {
+      myViewer.Context()->Deactivate (theObject, AIS_Shape::SelectionMode (theOldMode));
+      myViewer.Context()->Activate (theObject, AIS_Shape::SelectionMode (theNewMode));
+    }
+
+    virtual void GetSelectedObjects (std::vector<const AIS_InteractiveObject*>& theObjects) const override
+    {
+      const Handle(AIS_InteractiveContext)& aCtx = myViewer.Context();
+      for (aCtx->InitSelected(); aCtx->MoreSelected(); aCtx->NextSelected())
+      {
+        theObjects.push_back (aCtx->SelectedInteractive().get());
+      }
+    }
+
+    virtual void GetSelectedPartIDs (std::vector<int>& theGeometryIDs) const override
+    {
+      const Handle(AIS_InteractiveContext)& aCtx = myViewer.Context();
+      for (aCtx->InitSelected(); aCtx->MoreSelected(); aCtx->NextSelected())
+      {
+        if (Handle(MergedPartOwner) anOwner = Handle(MergedPartOwner)::DownCast (aCtx->SelectedOwner()))
+        {
+          theGeometryIDs.push_back (anOwner->GetGeometryID());
+        }
+      }
+    }
+
+    virtual void Update() override { myViewer.UpdateView(); }
+
+    virtual size_t EstimatePresentationBytes (const Handle(AIS_InteractiveObject)& theObject) const override
+    {
+      Standard_Size aNbBytes = 0;
+      for (PrsMgr_Presentations::Iterator aPrsIter (theObject->Presentations()); aPrsIter.More(); aPrsIter.Next())
+      {
+        const Handle(Graphic3d_CStructure)& aCStruct = aPrsIter.Value()->CStructure();
+        if (aCStruct.IsNull())
+        {
+          continue;
+        }
+        for (Graphic3d_SequenceOfGroup::Iterator aGroupIter (aCStruct->Groups()); aGroupIter.More(); aGroupIter.Next())
+        {
+          const OpenGl_Group* aGroup = dynamic_cast<const OpenGl_Group*> (aGroupIter.Value().get());
+          for (const OpenGl_ElementNode* aNode = aGroup != NULL ? aGroup->FirstNode() : NULL; aNode != NULL; aNode = aNode->next)
+          {
+            aNbBytes += aNode->elem->EstimatedDataSize();
+          }
+        }
+      }
+      return aNbBytes;
+    }
+
+  private:
+    WasmOcctView& myViewer;
+  };
+
   //! Auxiliary wrapper for loading model.
   struct ModelAsyncLoader
   {
@@ -116,6 +212,27 @@ namespace
   };
 }
 
+namespace
+{
+  //! Sorts theTimes and returns their average and 95th percentile.
+  void summarizeTimes (std::vector<double>& theTimes, double& theAvg, double& theP95)
+  {
+    std::sort (theTimes.begin(), theTimes.end());
+    double aSum = 0.0;
+    for (double aTime : theTimes) { aSum += aTime; }
+    theAvg = theTimes.empty() ? 0.0 : aSum / (double )theTimes.size();
+    theP95 = theTimes.empty() ? 0.0 : theTimes[(size_t )(0.95 * (double )(theTimes.size() - 1))];
+  }
+
+  //! Prints the statistics of a finished input replay.
+  void sendInputReplayStats (const InputReplay::Stats& theStats)
+  {
+    Message::SendInfo() << "Input replay: " << (int )theStats.FrameCount << " frames, " << (int )theStats.EventCount << " events in "
+                        << theStats.WallMs << " ms, frame mean " << theStats.MeanFrameMs << " ms, p50 " << theStats.P50FrameMs
+                        << " ms, p95 " << theStats.P95FrameMs << " ms, p99 " << theStats.P99FrameMs << " ms, max " << theStats.MaxFrameMs << " ms";
+  }
+}
+
 // Initialize static variable
 bool WasmOcctView::m_bShowScale = false;
 
@@ -132,8 +249,8 @@ WasmOcctView& WasmOcctView::Instance()
 WasmOcctView::WasmOcctView()
 : myDevicePixelRatio (1.0f),
   myUpdateRequests (0),
-    m_SelectionMode(TopAbs_SOLID),
-    m_ImGuiContext(nullptr)
+    m_ImGuiContext(nullptr),
+    m_RedrawScheduler(onRedrawView, this)
 {
   addActionHotKeys (Aspect_VKey_NavForward,        Aspect_VKey_W, Aspect_VKey_W | Aspect_VKeyFlags_SHIFT);
   addActionHotKeys (Aspect_VKey_NavBackward ,      Aspect_VKey_S, Aspect_VKey_S | Aspect_VKeyFlags_SHIFT);
@@ -201,9 +318,41 @@ void WasmOcctView::cleanup()
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext(m_ImGuiContext);
 
+    if (!m_SceneFbo.IsNull())
+    {
+        myView->View()->SetFBO (Handle(Standard_Transient)());
+        m_SceneFbo->Release (m_GLContext.get());
+        m_SceneFbo.Nullify();
+    }
     myView->Remove();
 }
 
+//! Report the canvas position through onCanvasLayoutChanged() now and whenever it may change:
+//! window resize or scroll, canvas resize, or style/class changes and insertions along its ancestor chain.
+//! getBoundingClientRect() forces a layout, so it is not called per mouse event.
+EM_JS(void, jsObserveCanvasLayout, (), {
+  var aCanvas = Module.canvas;
+  var isPending = false;
+  var anUpdate = function() {
+    isPending = false;
+    var aRect = aCanvas.getBoundingClientRect();
+    Module.onCanvasLayoutChanged(aRect.left, aRect.top);
+  };
+  // scroll and observers may fire in bursts, the position is read once per frame for them
+  var aSchedule = function() {
+    if (!isPending) { isPending = true; requestAnimationFrame(anUpdate); }
+  };
+  window.addEventListener('resize', anUpdate, { passive: true });
+  window.addEventListener('scroll', aSchedule, { capture: true, passive: true }); // scrolled ancestors as well
+  if (typeof ResizeObserver !== 'undefined') { new ResizeObserver(aSchedule).observe(aCanvas); }
+  // style/class changes and inserted or removed children along the ancestor chain, not the whole page
+  var anObserver = new MutationObserver(aSchedule);
+  for (var anElem = aCanvas; anElem; anElem = anElem.parentElement) {
+    anObserver.observe(anElem, { attributes: true, attributeFilter: ['style', 'class'], childList: true });
+  }
+  anUpdate();
+});
+
 // ================================================================
 // Function : initWindow
 // Purpose  :
@@ -240,6 +389,9 @@ void WasmOcctView::initWindow()
   //emscripten_set_focus_callback    (aTargetId, this, toUseCapture, onFocusCallback);
   //emscripten_set_focusin_callback  (aTargetId, this, toUseCapture, onFocusCallback);
   emscripten_set_focusout_callback   (aTargetId, this, toUseCapture, onFocusCallback);
+  emscripten_set_visibilitychange_callback (this, toUseCapture, onVisibilityCallback);
+
+  jsObserveCanvasLayout();
 }
 
 // ================================================================
@@ -325,20 +477,6 @@ void WasmOcctView::s_onWindowResized(GLFWwindow* window, int width, int height)
     glViewport(0, 0, width, height);
 }
 
-void WasmOcctView::s_onMouseButton(GLFWwindow* window, int button, int action, int mods)
-{
-		ImGui_ImplGlfw_MouseButtonCallback(window, button, action, mods);
-	  WasmOcctView* view = reinterpret_cast<WasmOcctView*>(glfwGetWindowUserPointer(window));
-	  SPDLOG_INFO("Mouse Button Event: {}", button);
-}
-
-void WasmOcctView::s_onMouseMove(GLFWwindow* window, double thePosX, double thePosY)
-{
-		ImGui_ImplGlfw_CursorPosCallback(window, thePosX, thePosY);
-	  WasmOcctView* view = reinterpret_cast<WasmOcctView*>(glfwGetWindowUserPointer(window));
-	  //SPDLOG_INFO("Mouse Move Event");
-}
-
 
 // ================================================================
 // Function : initViewer
@@ -370,6 +508,7 @@ bool WasmOcctView::initViewer()
 
   Handle(V3d_Viewer) aViewer = new V3d_Viewer (aDriver);
   aViewer->SetComputedMode (false);
+  m_SizeCulling.Init (aViewer);
   aViewer->SetDefaultShadingModel (Graphic3d_TypeOfShadingModel_Phong);
   aViewer->SetDefaultLights();
   aViewer->SetLightOn();
@@ -437,6 +576,10 @@ bool WasmOcctView::initViewer()
   myContext->HighlightStyle(Prs3d_TypeOfHighlight_LocalSelected)->SetColor(Quantity_NOC_INDIANRED);
   myContext->HighlightStyle(Prs3d_TypeOfHighlight_LocalSelected)->SetTransparency(0.2f);
   myContext->HighlightStyle(Prs3d_TypeOfHighlight_LocalSelected)->SetDisplayMode(AIS_Shaded);
+  // Keep hover highlighting in an immediate layer: a detection change is then drawn by RedrawImmediate()
+  // over the cached main scene, the shaded transparent shadow presentations never touch the scene itself.
+  myContext->HighlightStyle(Prs3d_TypeOfHighlight_Dynamic)->SetZLayer(Graphic3d_ZLayerId_Top);
+  myContext->HighlightStyle(Prs3d_TypeOfHighlight_LocalDynamic)->SetZLayer(Graphic3d_ZLayerId_Top);
 
   // To Remove Unnecessary Wires On Curved Surface
   myContext->SetIsoNumber(0);
@@ -444,11 +587,12 @@ bool WasmOcctView::initViewer()
 	myContext->DefaultDrawer()->SetFaceBoundaryDraw(Standard_True);
 	myContext->SetDisplayMode(AIS_Shaded, Standard_False);
 
+  // Route geometry display and selection through this context
+  AppManager::GetInstance().SetDisplaySink (new ContextDisplaySink (*this));
+
     // window callback
     glfwSetWindowSizeCallback(aWindow->GetGlfwWindow(), WasmOcctView::s_onWindowResized);
-    // mouse callback
-    glfwSetMouseButtonCallback(aWindow->GetGlfwWindow(), WasmOcctView::s_onMouseButton);
-    glfwSetCursorPosCallback(aWindow->GetGlfwWindow(), WasmOcctView::s_onMouseMove);
+    // mouse input reaches ImGui through InputRouter, see onMouseEvent()
 
     // ImGui Initialization
     m_ImGuiContext = ImGui::CreateContext();
@@ -464,6 +608,9 @@ bool WasmOcctView::initViewer()
     io.Fonts->AddFontFromFileTTF("resources/fonts/Consolas.ttf", fontSize);
 
     ImGui_ImplGlfw_InitForOpenGL(aWindow->GetGlfwWindow(), false);
+    // Mark the cursor as tracked, so NewFrame() does not poll GLFW for a position on top of InputRouter
+    ImGui_ImplGlfw_CursorEnterCallback(aWindow->GetGlfwWindow(), GLFW_TRUE);
+    m_InputRouter.SetCanvasSize(Graphic3d_Vec2i(width, height));
 
     ImGui_ImplOpenGL3_Init();
     ImGui_ImplOpenGL3_CreateFontsTexture();
@@ -498,6 +645,7 @@ void WasmOcctView::initDemoScene()
   myContext->Display (myViewCube, false);
 
   onRedrawView(this);
+  m_RedrawScheduler.Request();  // starts the frame loop
   // Build with "--preload-file MySampleFile.brep" option to load some shapes here.
 }
 
@@ -512,10 +660,9 @@ void WasmOcctView::ProcessInput()
     // Queue onRedrawView()/redrawView callback to redraw canvas after all user input is flushed by browser.
     // Redrawing viewer on every single message would be a pointless waste of resources,
     // as user will see only the last drawn frame due to WebGL implementation details.
-    if (++myUpdateRequests == 1)
-    {
-      emscripten_async_call (onRedrawView, this, 0);
-    }
+    // The scheduler coalesces requests into the next animation frame.
+    ++myUpdateRequests;
+    m_RedrawScheduler.Request();
   }
 }
 
@@ -540,13 +687,63 @@ void WasmOcctView::UpdateView()
 // ================================================================
 void WasmOcctView::redrawView()
 {
+    TRACE_SCOPE("WasmOcctView::redrawView");
     if (!myView.IsNull())
     {
-        FlushViewEvents(myContext, myView, true); 
+        m_PerfOverlay.BeginFrame();
+        m_PerfOverlay.SetPendingUpdates(myUpdateRequests);
+        m_InputReplay.BeginFrame(*this);
+
+        // Triangle and element counters cost a scene traversal, collect them only while the panel is open
+        Graphic3d_RenderingParams::PerfCounters aCounters = Graphic3d_RenderingParams::PerfCounters_Basic;
+        if (m_PerfOverlay.IsVisible())
+        {
+            aCounters = Graphic3d_RenderingParams::PerfCounters (aCounters
+                      | Graphic3d_RenderingParams::PerfCounters_Groups
+                      | Graphic3d_RenderingParams::PerfCounters_GroupArrays
+                      | Graphic3d_RenderingParams::PerfCounters_Triangles);
+        }
+        if (myView->RenderingParams().CollectedStats != aCounters)
+        {
+            myView->ChangeRenderingParams().CollectedStats = aCounters;
+        }
+        updateSceneCache();
+
+        {
+            TRACE_SCOPE("AIS_ViewController::FlushViewEvents");
+            const double aFlushBegin = PerfOverlay::NowMs();
+            FlushViewEvents(myContext, myView, true);
+            m_InputRecorder.RecordFrame();
+            // handleViewRedraw() accounts for the 3D part itself
+            m_PerfOverlay.AddPhaseTime (FramePhase::InputFlush, PerfOverlay::NowMs() - aFlushBegin
+                                                              - m_PerfOverlay.GetPhaseTime (FramePhase::Redraw3D));
+        }
+
+        {
+            // Kept current for sizeCullingStats() as well
+            const Graphic3d_FrameStatsData& aStats = m_GLContext->FrameStats()->LastDataFrame();
+            m_SizeCulling.SetFrameStats (aStats[Graphic3d_FrameStatsCounter_NbStructs],
+                                         aStats[Graphic3d_FrameStatsCounter_NbStructsNotCulled],
+                                         aStats[Graphic3d_FrameStatsCounter_NbElemsNotCulled]);
+            if (m_PerfOverlay.IsVisible())
+            {
+                m_PerfOverlay.SetFrameStats (aStats[Graphic3d_FrameStatsCounter_NbElemsNotCulled],
+                                             aStats[Graphic3d_FrameStatsCounter_NbTrianglesNotCulled],
+                                             aStats[Graphic3d_FrameStatsCounter_NbStructsNotCulled]);
+                m_PerfOverlay.SetCulledStructures (m_SizeCulling.GetStats().CulledStructures, m_SizeCulling.GetStats().TotalStructures);
+            }
+        }
 
         m_GLContext->MakeCurrent();  // by skpark
         //myView->Invalidate();  // by skpark
+        {
+            TRACE_SCOPE("WasmOcctView::composeSceneCache");
+            const double aComposeBegin = PerfOverlay::NowMs();
+            composeSceneCache();
+            m_PerfOverlay.AddPhaseTime (FramePhase::Redraw3D, PerfOverlay::NowMs() - aComposeBegin);
+        }
 
+        const double aBuildBegin = PerfOverlay::NowMs();
         ImGui_ImplGlfw_NewFrame();
         ImGui_ImplOpenGL3_NewFrame();
         ImGui::NewFrame();
@@ -562,6 +759,18 @@ void WasmOcctView::redrawView()
             }
             ImGui::DragFloat3("Box location", m_Location);
             ImGui::Separator();
+            ImGui::Checkbox("Performance", m_PerfOverlay.GetVisiblePtr());
+            ImGui::Checkbox("Memory", m_MemoryPanel.GetVisiblePtr());
+            ImGui::Checkbox("Dynamic resolution", &m_DynamicResolution.ChangeSettings().Enabled);
+            bool isMergedStatic = AppManager::GetInstance().IsMergedStatic();
+            ImGui::BeginDisabled(isMergedStatic);  // Both act on per-solid objects
+            ImGui::Checkbox("Interaction LOD", &m_InteractionLod.ChangeSettings().Enabled);
+            ImGui::Checkbox("Size culling", m_SizeCulling.GetEnabledPtr());
+            ImGui::EndDisabled();
+            if (ImGui::Checkbox("Merged static", &isMergedStatic)) {
+                setMergedStatic(isMergedStatic);
+            }
+            ImGui::Separator();
             if (ImGui::Button("Show Scale")) {
                 showScale();
             }
@@ -591,11 +800,36 @@ void WasmOcctView::redrawView()
         ImGui::End();
 
         ImGui::ShowDemoWindow();
+        m_PerfOverlay.Draw();
+        m_MemoryPanel.Draw();
 
-        ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        const double aRenderBegin = PerfOverlay::NowMs();
+        m_PerfOverlay.AddPhaseTime (FramePhase::ImGuiBuild, aRenderBegin - aBuildBegin);
+        {
+            TRACE_SCOPE("ImGui::Render");
+            ImGui::Render();
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
+        m_PerfOverlay.AddPhaseTime (FramePhase::ImGuiRender, PerfOverlay::NowMs() - aRenderBegin);
 
-        m_GLContext->SwapBuffers();  // by skpark       
+        {
+            TRACE_SCOPE("OpenGl_Context::SwapBuffers");
+            m_GLContext->SwapBuffers();  // by skpark
+        }
+        m_PerfOverlay.EndFrame();
+
+        if (m_InputReplay.IsPlaying())
+        {
+            m_InputReplay.EndFrame();
+            if (m_InputReplay.IsPlaying())
+            {
+                m_RedrawScheduler.Request();
+            }
+            else
+            {
+                sendInputReplayStats (m_InputReplay.GetStats());
+            }
+        }
     }
     glfwPollEvents();
 }
@@ -608,16 +842,139 @@ void WasmOcctView::handleViewRedraw (const Handle(AIS_InteractiveContext)& theCt
                                      const Handle(V3d_View)& theView)
 {
   myUpdateRequests = 0;
-  AIS_ViewController::handleViewRedraw (theCtx, theView);
-  setAskNextFrame();
-  if (myToAskNextFrame)
+
+  const bool hasCache = !m_SceneFbo.IsNull();
+  if (hasCache && !m_bSceneCached)
+  {
+    theView->Invalidate();  // new or resized cache
+  }
+  const bool isAnimated = !myViewAnimation.IsNull() && !myViewAnimation->IsStopped();
+
+  // FlushViewEvents() has already applied navigation to the camera
+  const Graphic3d_WorldViewProjState aCameraState = theView->Camera()->WorldViewProjState();
+  const bool isMoving = isAnimated || aCameraState != m_CameraState;
+  m_CameraState = aCameraState;
+  const float aRenderScale = m_DynamicResolution.Update (isMoving, PerfOverlay::NowMs());
+  if (theView->RenderingParams().RenderResolutionScale != aRenderScale)
+  {
+    theView->ChangeRenderingParams().RenderResolutionScale = aRenderScale;
+    theView->Invalidate();
+  }
+  m_PerfOverlay.SetRenderScale (aRenderScale, m_DynamicResolution.GetChangeCount());
+
+  // A button held without motion still counts as interacting, so proxies do not flicker between drag steps
+  const bool isInteracting = isMoving || myMouseActiveGesture != AIS_MouseGesture_NONE;
+  if (m_InteractionLod.Update (theCtx, theView, isInteracting, PerfOverlay::NowMs()))
+  {
+    theView->Invalidate();
+  }
+  m_PerfOverlay.SetInteractionLod (m_InteractionLod.GetStats().ProxyCount, m_InteractionLod.GetStats().LoweredCount);
+
+  if (m_SizeCulling.Apply (theView->Viewer()))
+  {
+    theView->Invalidate();
+  }
+
+  const bool isInvalidated = theView->IsInvalidated();
+  if (hasCache && !isInvalidated && !theView->IsInvalidatedImmediate() && !isAnimated)
   {
-    // ask more frames
+    // Camera, scene and highlight are unchanged: redrawView() composes ImGui over the cached 3D image
+    m_PerfOverlay.SetRedrawKind (RedrawKind::Cached);
+  }
+  else
+  {
+    if (!hasCache && !isInvalidated)
+    {
+      // Rendering straight to the window, whose drawing buffer is not preserved: recompose the main scene
+      // cached by OpenGl_View and redraw only immediate layers (hover highlight)
+      theView->InvalidateImmediate();
+    }
+
+    const double aRedrawBegin = PerfOverlay::NowMs();
+    AIS_ViewController::handleViewRedraw (theCtx, theView);
+    const double aRedrawMs = PerfOverlay::NowMs() - aRedrawBegin;
+    m_PerfOverlay.AddPhaseTime (FramePhase::Redraw3D, aRedrawMs);
+    if (isInvalidated)
+    {
+      m_DynamicResolution.AddRedrawSample (aRedrawMs);
+      if (m_bMeasureBatchUpload)
+      {
+        // vertex buffers of new presentations are created by their first redraw
+        m_BatchUploadMs = aRedrawMs;
+        m_bMeasureBatchUpload = false;
+      }
+    }
+    // Animations ask the next frame from within the base method, which redraws the whole view then
+    m_PerfOverlay.SetRedrawKind (isInvalidated || myToAskNextFrame ? RedrawKind::Full : RedrawKind::Immediate);
+    m_bSceneCached = hasCache;
+  }
+
+  if (myToAskNextFrame
+   || aRenderScale < 1.0f
+   || m_InteractionLod.IsActive())
+  {
+    // ask more frames (animations, restoring full detail at rest), the scheduler also keeps drawing ImGui unless in idle mode
     ++myUpdateRequests;
-    emscripten_async_call(onRedrawView, this, 0);
+    m_RedrawScheduler.Request();
   }
 }
 
+// ================================================================
+// Function : updateSceneCache
+// Purpose  :
+// ================================================================
+void WasmOcctView::updateSceneCache()
+{
+  if (m_GLContext.IsNull()
+   || m_GLContext->arbFBOBlit == NULL)
+  {
+    return; // the 3D view keeps rendering to the window
+  }
+
+  Graphic3d_Vec2i aWinSize;
+  myView->Window()->Size (aWinSize.x(), aWinSize.y());
+  if (!m_SceneFbo.IsNull()
+   && m_SceneFbo->GetVPSizeX() == aWinSize.x()
+   && m_SceneFbo->GetVPSizeY() == aWinSize.y())
+  {
+    return;
+  }
+
+  if (m_SceneFbo.IsNull())
+  {
+    m_SceneFbo = new OpenGl_FrameBuffer();
+  }
+  m_bSceneCached = false;
+  if (!m_SceneFbo->Init (m_GLContext, aWinSize, GL_RGBA8, GL_DEPTH24_STENCIL8))
+  {
+    Message::DefaultMessenger()->Send (TCollection_AsciiString ("Warning: 3D frame cache cannot be allocated"), Message_Warning);
+    m_SceneFbo->Release (m_GLContext.get());
+    m_SceneFbo.Nullify();
+    myView->View()->SetFBO (Handle(Standard_Transient)());
+    return;
+  }
+  myView->View()->SetFBO (m_SceneFbo);
+}
+
+// ================================================================
+// Function : composeSceneCache
+// Purpose  :
+// ================================================================
+void WasmOcctView::composeSceneCache()
+{
+  if (m_SceneFbo.IsNull())
+  {
+    return;
+  }
+
+  const Standard_Integer aSizeX = m_SceneFbo->GetVPSizeX();
+  const Standard_Integer aSizeY = m_SceneFbo->GetVPSizeY();
+  m_SceneFbo->BindReadBuffer (m_GLContext);
+  m_GLContext->arbFBO->glBindFramebuffer (GL_DRAW_FRAMEBUFFER, OpenGl_FrameBuffer::NO_FRAMEBUFFER);
+  m_GLContext->arbFBOBlit->glBlitFramebuffer (0, 0, aSizeX, aSizeY, 0, 0, aSizeX, aSizeY, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+  m_GLContext->arbFBO->glBindFramebuffer (GL_FRAMEBUFFER, OpenGl_FrameBuffer::NO_FRAMEBUFFER);
+}
+
 // EM_BOOL WasmOcctView::onResizeCallback(int theEventType, const EmscriptenUiEvent* theEvent, void* theView)
 // {
 //     int width, height;
@@ -645,6 +1002,7 @@ EM_BOOL WasmOcctView::onResizeEvent (int theEventType, const EmscriptenUiEvent*
   Graphic3d_Vec2i aWinSizeNew;
   aWindow->DoResize();
   aWindow->Size (aWinSizeNew.x(), aWinSizeNew.y());
+  m_InputRouter.SetCanvasSize (aWinSizeNew);
   const float aPixelRatio = emscripten_get_device_pixel_ratio();
   if (aWinSizeNew != myWinSizeOld
    || aPixelRatio != myDevicePixelRatio)
@@ -657,6 +1015,7 @@ EM_BOOL WasmOcctView::onResizeEvent (int theEventType, const EmscriptenUiEvent*
     }
 
     myView->MustBeResized();
+    updateSceneCache();
     myView->Invalidate();
     myView->Redraw();
     dumpGlInfo (true);
@@ -664,72 +1023,29 @@ EM_BOOL WasmOcctView::onResizeEvent (int theEventType, const EmscriptenUiEvent*
   return EM_TRUE;
 }
 
-//! Update canvas bounding rectangle.
-EM_JS(void, jsUpdateBoundingClientRect, (), {
-  Module._myCanvasRect = Module.canvas.getBoundingClientRect();
-});
-
-//! Get canvas bounding top.
-EM_JS(int, jsGetBoundingClientTop, (), {
-  return Math.round(Module._myCanvasRect.top);
-});
-
-//! Get canvas bounding left.
-EM_JS(int, jsGetBoundingClientLeft, (), {
-  return Math.round(Module._myCanvasRect.left);
-});
-
 // ================================================================
 // Function : onMouseEvent
 // Purpose  :
 // ================================================================
 EM_BOOL WasmOcctView::onMouseEvent (int theEventType, const EmscriptenMouseEvent* theEvent)
 {
-    ImGuiIO& io = ImGui::GetIO();  
-    if (io.WantCaptureMouse) {
-        myView->Invalidate();
-        return EM_FALSE;
-    }
-
-    EmscriptenMouseEvent anEvent = *theEvent;
-
-    if (myView.IsNull())
-    {
-      return EM_FALSE;
-    }
-
-    Handle(GlfwOcctWindow) aWindow = Handle(GlfwOcctWindow)::DownCast(myView->Window());
-
-    if (theEventType == EMSCRIPTEN_EVENT_MOUSEUP) {
-        Standard_Integer btnNumber = (Standard_Integer)anEvent.button;
-
-        if (btnNumber == 0)  // L-Button
-        {
-            Message::DefaultMessenger()->Send(TCollection_AsciiString("L-Button Clicked!"), Message_Info);
-        }
-        else if (btnNumber == 1)  // Scroll-Button
-        {
-            Message::DefaultMessenger()->Send(TCollection_AsciiString("Scroll-Button Clicked!"), Message_Info);
-        }
-        else if (btnNumber == 2)  // R-Button
-        {
-            Message::DefaultMessenger()->Send(TCollection_AsciiString("R-Button Clicked!"), Message_Info);
-        }
-    }
+  if (myView.IsNull())
+  {
+    return EM_FALSE;
+  }
 
-    if (theEventType == EMSCRIPTEN_EVENT_MOUSEMOVE
-    || theEventType == EMSCRIPTEN_EVENT_MOUSEUP)
-    {
-        // these events are bound to EMSCRIPTEN_EVENT_TARGET_WINDOW, and coordinates should be converted
-        jsUpdateBoundingClientRect();
-        EmscriptenMouseEvent anEvent = *theEvent;
-        anEvent.targetX -= jsGetBoundingClientLeft();
-        anEvent.targetY -= jsGetBoundingClientTop();
-        aWindow->ProcessMouseEvent(*this, theEventType, &anEvent);
-        return EM_FALSE;
-    }
+  const bool isWindowEvent = theEventType == EMSCRIPTEN_EVENT_MOUSEMOVE
+                          || theEventType == EMSCRIPTEN_EVENT_MOUSEUP;
+  // these events are bound to EMSCRIPTEN_EVENT_TARGET_WINDOW, and coordinates should be converted
+  const Graphic3d_Vec2d aCanvasOffset = isWindowEvent ? m_CanvasOffset : Graphic3d_Vec2d (0.0);
 
-  return aWindow->ProcessMouseEvent(*this, theEventType, theEvent) ? EM_TRUE : EM_FALSE;
+  PointerEvent anEvent;
+  if (!InputRouter::DecodeMouseEvent (theEventType, *theEvent, aCanvasOffset, myDevicePixelRatio, anEvent))
+  {
+    return EM_FALSE;
+  }
+  const bool isHandled = m_InputRouter.Dispatch (anEvent, *this);
+  return isHandled && !isWindowEvent ? EM_TRUE : EM_FALSE;
 }
 
 // ================================================================
@@ -738,14 +1054,14 @@ EM_BOOL WasmOcctView::onMouseEvent (int theEventType, const EmscriptenMouseEvent
 // ================================================================
 EM_BOOL WasmOcctView::onWheelEvent (int theEventType, const EmscriptenWheelEvent* theEvent)
 {
+  PointerEvent anEvent;
   if (myView.IsNull()
-   || theEventType != EMSCRIPTEN_EVENT_WHEEL)
+   || !InputRouter::DecodeWheelEvent (theEventType, *theEvent, myDevicePixelRatio, anEvent))
   {
     return EM_FALSE;
   }
 
-  Handle(GlfwOcctWindow) aWindow = Handle(GlfwOcctWindow)::DownCast (myView->Window());
-  return aWindow->ProcessWheelEvent (*this, theEventType, theEvent) ? EM_TRUE : EM_FALSE;
+  return m_InputRouter.Dispatch (anEvent, *this) ? EM_TRUE : EM_FALSE;
 }
 
 // ================================================================
@@ -763,6 +1079,17 @@ EM_BOOL WasmOcctView::onTouchEvent (int theEventType, const EmscriptenTouchEvent
   return aWindow->ProcessTouchEvent (*this, theEventType, theEvent) ? EM_TRUE : EM_FALSE;
 }
 
+// ================================================================
+// Function : onVisibilityEvent
+// Purpose  :
+// ================================================================
+EM_BOOL WasmOcctView::onVisibilityEvent (int theEventType, const EmscriptenVisibilityChangeEvent* theEvent)
+{
+  (void )theEventType;
+  m_RedrawScheduler.SetPageHidden (theEvent->hidden);
+  return EM_FALSE;
+}
+
 // ================================================================
 // Function : navigationKeyModifierSwitch
 // Purpose  :
@@ -842,6 +1169,7 @@ void WasmOcctView::KeyDown (Aspect_VKey theKey,
                             double theTime,
                             double thePressure)
 {
+  m_InputRecorder.RecordKey (InputRecord::Kind::KeyDown, theKey);
   const unsigned int aModifOld = myKeys.Modifiers();
   AIS_ViewController::KeyDown (theKey, theTime, thePressure);
 
@@ -883,6 +1211,7 @@ EM_BOOL WasmOcctView::onKeyUpEvent (int theEventType, const EmscriptenKeyboardEv
 void WasmOcctView::KeyUp (Aspect_VKey theKey,
                           double theTime)
 {
+  m_InputRecorder.RecordKey (InputRecord::Kind::KeyUp, theKey);
   const unsigned int aModifOld = myKeys.Modifiers();
   AIS_ViewController::KeyUp (theKey, theTime);
 
@@ -946,17 +1275,57 @@ void WasmOcctView::setCubemapBackground (const std::string& theImagePath)
 void WasmOcctView::fitAllObjects (bool theAuto)
 {
   WasmOcctView& aViewer = Instance();
-  if (theAuto)
+  Bnd_Box aBox;
+  if (theAuto
+   && aViewer.Context()->NbSelected() > 0)
   {
-    aViewer.FitAllAuto (aViewer.Context(), aViewer.View());
+    aBox = AppManager::GetInstance().GetSelectionBounds();
+    if (aBox.IsVoid())
+    {
+      // selection doesn't belong to imported geometry
+      aViewer.FitAllAuto (aViewer.Context(), aViewer.View());
+      aViewer.UpdateView();
+      return;
+    }
   }
   else
   {
-    aViewer.View()->FitAll (0.01, false);
+    aBox = aViewer.sceneBounds();
+  }
+
+  if (!aBox.IsVoid())
+  {
+    aViewer.View()->FitAll (aBox, 0.01, false);
   }
   aViewer.UpdateView();
 }
 
+// ================================================================
+// Function : sceneBounds
+// Purpose  :
+// ================================================================
+Bnd_Box WasmOcctView::sceneBounds() const
+{
+  Bnd_Box aBox = AppManager::GetInstance().GetSceneBounds();
+  if (aBox.IsVoid())
+  {
+    // nothing imported, ask the presentations
+    return myView->View()->MinMaxValues();
+  }
+
+  for (NCollection_IndexedDataMap<TCollection_AsciiString, Handle(AIS_InteractiveObject)>::Iterator anObjIter (myObjects);
+       anObjIter.More(); anObjIter.Next())
+  {
+    if (myContext->IsDisplayed (anObjIter.Value()))
+    {
+      Bnd_Box anObjBox;
+      anObjIter.Value()->BoundingBox (anObjBox);
+      aBox.Add (anObjBox);
+    }
+  }
+  return aBox;
+}
+
 // ================================================================
 // Function : removeAllObjects
 // Purpose  :
@@ -1178,6 +1547,8 @@ bool WasmOcctView::openSTEPFromMemory (const std::string& theName,
     std::istream aStream(&aStreamBuffer);
 
     app.ImportGeometry(theName.c_str(), aStream, GeomFileType::STEP);    
+    Instance().m_MemoryPanel.Invalidate();
+    Instance().m_bMeasureBatchUpload = app.IsMergedStatic();  // batches were rebuilt with the new parts
     fitAllObjects(true);
 
     return true;
@@ -1312,7 +1683,7 @@ void WasmOcctView::displayGround (bool theToShow)
   if (theToShow)
   {
     aViewer.Context()->Remove (aGroundPrs, false);
-    aBox = aViewer.View()->View()->MinMaxValues();
+    aBox = aViewer.sceneBounds();
   }
   if (aBox.IsVoid()
   ||  aBox.IsZThin (Precision::Confusion()))
@@ -1395,6 +1766,560 @@ void WasmOcctView::showScale()
     }
 }
 
+// ================================================================
+// Function : translateGeometry
+// Purpose  :
+// ================================================================
+bool WasmOcctView::translateGeometry (const std::string& theName,
+                                      double theDX, double theDY, double theDZ)
+{
+  return AppManager::GetInstance().TranslateGeometry (theName, theDX, theDY, theDZ);
+}
+
+// ================================================================
+// Function : setGeometryVisible
+// Purpose  :
+// ================================================================
+bool WasmOcctView::setGeometryVisible (const std::string& theName, bool theToShow)
+{
+  return AppManager::GetInstance().SetGeometryVisible (theName, theToShow);
+}
+
+// ================================================================
+// Function : queryRegion
+// Purpose  :
+// ================================================================
+emscripten::val WasmOcctView::queryRegion (double theXMin, double theYMin, double theZMin,
+                                           double theXMax, double theYMax, double theZMax)
+{
+  Bnd_Box aRegion;
+  aRegion.Update (theXMin, theYMin, theZMin, theXMax, theYMax, theZMax);
+  std::vector<int> anIds;
+  AppManager::GetInstance().QueryRegion (aRegion, anIds);
+
+  emscripten::val anArray = emscripten::val::array();
+  for (size_t anIter = 0; anIter < anIds.size(); ++anIter)
+  {
+    anArray.set (anIter, anIds[anIter]);
+  }
+  return anArray;
+}
+
+// ================================================================
+// Function : benchmarkSubassemblyMove
+// Purpose  :
+// ================================================================
+emscripten::val WasmOcctView::benchmarkSubassemblyMove (const std::string& theName, int theNbFrames)
+{
+  WasmOcctView& aViewer = Instance();
+  AppManager& anApp = AppManager::GetInstance();
+  emscripten::val aResult = emscripten::val::object();
+  if (aViewer.View().IsNull() || aViewer.m_GLContext.IsNull() || theNbFrames <= 0)
+  {
+    return aResult;
+  }
+
+  std::vector<double> aMoveTimes, aRedrawTimes;
+  aMoveTimes.reserve (theNbFrames);
+  aRedrawTimes.reserve (theNbFrames);
+  for (int aFrameIter = 0; aFrameIter < theNbFrames; ++aFrameIter)
+  {
+    // back and forth, the subassembly ends where it started
+    const double aStep = (aFrameIter % 2 == 0) ? 1.0 : -1.0;
+    const double aMoveBegin = PerfOverlay::NowMs();
+    if (!anApp.TranslateGeometry (theName, aStep, 0.0, 0.0))
+    {
+      Message::SendFail() << "Subassembly move benchmark: no geometry named " << theName.c_str();
+      return aResult;
+    }
+    const double aRedrawBegin = PerfOverlay::NowMs();
+    // synchronous redraw, glFinish() so that the GPU work is included
+    aViewer.View()->Redraw();
+    aViewer.m_GLContext->core11fwd->glFinish();
+    const double aRedrawEnd = PerfOverlay::NowMs();
+    aMoveTimes.push_back (aRedrawBegin - aMoveBegin);
+    aRedrawTimes.push_back (aRedrawEnd - aRedrawBegin);
+  }
+  if (theNbFrames % 2 != 0)
+  {
+    anApp.TranslateGeometry (theName, -1.0, 0.0, 0.0);
+  }
+  aViewer.UpdateView();
+
+  double aMoveAvg = 0.0, aMoveP95 = 0.0, aRedrawAvg = 0.0, aRedrawP95 = 0.0;
+  summarizeTimes (aMoveTimes, aMoveAvg, aMoveP95);
+  summarizeTimes (aRedrawTimes, aRedrawAvg, aRedrawP95);
+  Message::SendInfo() << "Subassembly move benchmark: " << theName.c_str() << ", " << theNbFrames << " frames, "
+                      << "move avg " << aMoveAvg << " ms p95 " << aMoveP95 << " ms, "
+                      << "redraw avg " << aRedrawAvg << " ms p95 " << aRedrawP95 << " ms";
+
+  aResult.set ("nbFrames",    theNbFrames);
+  aResult.set ("moveAvgMs",   aMoveAvg);
+  aResult.set ("moveP95Ms",   aMoveP95);
+  aResult.set ("redrawAvgMs", aRedrawAvg);
+  aResult.set ("redrawP95Ms", aRedrawP95);
+  return aResult;
+}
+
+// ================================================================
+// Function : instanceMatrices
+// Purpose  :
+// ================================================================
+emscripten::val WasmOcctView::instanceMatrices()
+{
+  const std::vector<float>& aMatrices = AppManager::GetInstance().GetInstanceMatrices();
+  return emscripten::val (emscripten::typed_memory_view (aMatrices.size(), aMatrices.data()));
+}
+
+// ================================================================
+// Function : instanceGeometryIds
+// Purpose  :
+// ================================================================
+emscripten::val WasmOcctView::instanceGeometryIds()
+{
+  const std::vector<int>& anIds = AppManager::GetInstance().GetInstanceGeometryIDs();
+  return emscripten::val (emscripten::typed_memory_view (anIds.size(), anIds.data()));
+}
+
+// ================================================================
+// Function : traceDump
+// Purpose  :
+// ================================================================
+std::string WasmOcctView::traceDump()
+{
+  std::ostringstream aStream;
+  Trace::WriteChromeJson (aStream);
+  return aStream.str();
+}
+
+// ================================================================
+// Function : traceClear
+// Purpose  :
+// ================================================================
+void WasmOcctView::traceClear()
+{
+  Trace::Clear();
+}
+
+// ================================================================
+// Function : memoryReport
+// Purpose  :
+// ================================================================
+std::string WasmOcctView::memoryReport()
+{
+  std::ostringstream aStream;
+  AppManager::GetInstance().WriteMemoryReportJson (aStream);
+  return aStream.str();
+}
+
+// ================================================================
+// Function : setMemoryBudget
+// Purpose  :
+// ================================================================
+void WasmOcctView::setMemoryBudget (double theMegabytes)
+{
+  AppManager::GetInstance().SetMemoryBudget (theMegabytes > 0.0
+                                           ? static_cast<size_t> (theMegabytes * 1024.0 * 1024.0)
+                                           : MemoryGovernor::s_Unlimited);
+}
+
+// ================================================================
+// Function : setMergedStatic
+// Purpose  :
+// ================================================================
+void WasmOcctView::setMergedStatic (bool theIsEnabled)
+{
+  WasmOcctView& aViewer = Instance();
+  aViewer.myContext->ClearSelected (false);  // owners of the replaced objects
+  aViewer.m_SizeCulling.ReplaceExempt (aViewer.myContext, SizeCulling::Selected, {});  // no selection change callback then
+  // LOD and size culling switch per-solid objects, which are not displayed while merged
+  aViewer.m_InteractionLod.Restore (aViewer.myContext);
+  aViewer.m_InteractionLod.SetSuspended (theIsEnabled);
+  aViewer.m_SizeCulling.SetSuspended (theIsEnabled);
+  AppManager::GetInstance().SetMergedStatic (theIsEnabled);
+  aViewer.m_bMeasureBatchUpload = theIsEnabled;
+}
+
+// ================================================================
+// Function : setPlanarWithoutNormals
+// Purpose  :
+// ================================================================
+void WasmOcctView::setPlanarWithoutNormals (bool theIsEnabled)
+{
+  AppManager& anApp = AppManager::GetInstance();
+  if (anApp.IsMergedStatic())
+  {
+    Instance().myContext->ClearSelected (false);
+    Instance().m_SizeCulling.ReplaceExempt (Instance().myContext, SizeCulling::Selected, {});
+  }
+  anApp.SetPlanarWithoutNormals (theIsEnabled);
+  Instance().m_bMeasureBatchUpload = anApp.IsMergedStatic();
+}
+
+// ================================================================
+// Function : mergedBatchStats
+// Purpose  :
+// ================================================================
+emscripten::val WasmOcctView::mergedBatchStats()
+{
+  const MergedBatchStats& aStats = AppManager::GetInstance().GetMergedBatchStats();
+  emscripten::val aResult = emscripten::val::object();
+  aResult.set ("batchCount",    double(aStats.BatchCount));
+  aResult.set ("vertexCount",   double(aStats.VertexCount));
+  aResult.set ("triangleCount", double(aStats.TriangleCount));
+  aResult.set ("bufferBytes",   double(aStats.BufferBytes));
+  aResult.set ("buildMs",       aStats.BuildMs);
+  aResult.set ("uploadRedrawMs", Instance().m_BatchUploadMs);
+  return aResult;
+}
+
+// ================================================================
+// Function : memoryGovernorStats
+// Purpose  :
+// ================================================================
+emscripten::val WasmOcctView::memoryGovernorStats()
+{
+  const MemoryGovernor::Stats& aStats = AppManager::GetInstance().GetMemoryGovernorStats();
+  emscripten::val aResult = emscripten::val::object();
+  aResult.set ("budgetBytes",   aStats.BudgetBytes != MemoryGovernor::s_Unlimited ? double(aStats.BudgetBytes) : -1.0);
+  aResult.set ("residentBytes", double(aStats.ResidentBytes));
+  aResult.set ("evictedCount",  double(aStats.EvictedCount));
+  aResult.set ("evictionCount", double(aStats.EvictionCount));
+  aResult.set ("rebuildCount",  double(aStats.RebuildCount));
+  aResult.set ("evictedBytes",  double(aStats.EvictedBytes));
+  aResult.set ("peakResidentBytes", double(aStats.PeakResidentBytes));
+  return aResult;
+}
+
+// ================================================================
+// Function : enablePartStore
+// Purpose  :
+// ================================================================
+bool WasmOcctView::enablePartStore()
+{
+  return AppManager::GetInstance().EnablePartStore ("/parts");
+}
+
+// ================================================================
+// Function : partStoreStats
+// Purpose  :
+// ================================================================
+emscripten::val WasmOcctView::partStoreStats()
+{
+  const PartStore::Stats& aStats = AppManager::GetInstance().GetPartStoreStats();
+  emscripten::val aResult = emscripten::val::object();
+  aResult.set ("storedCount", double(aStats.StoredCount));
+  aResult.set ("storedBytes", double(aStats.StoredBytes));
+  aResult.set ("loadCount",   double(aStats.LoadCount));
+  aResult.set ("avgLoadMs",   aStats.LoadCount != 0 ? aStats.TotalLoadMs / aStats.LoadCount : 0.0);
+  aResult.set ("maxLoadMs",   aStats.MaxLoadMs);
+  aResult.set ("lastLoadMs",  aStats.LastLoadMs);
+  return aResult;
+}
+
+// ================================================================
+// Function : setTargetFps
+// Purpose  :
+// ================================================================
+void WasmOcctView::setTargetFps (double theFps)
+{
+  Instance().m_RedrawScheduler.SetTargetFps (theFps);
+}
+
+// ================================================================
+// Function : setIdleMode
+// Purpose  :
+// ================================================================
+void WasmOcctView::setIdleMode (bool theIsIdle)
+{
+  Instance().m_RedrawScheduler.SetIdleMode (theIsIdle);
+}
+
+// ================================================================
+// Function : setAnimationFramePacing
+// Purpose  :
+// ================================================================
+void WasmOcctView::setAnimationFramePacing (bool theIsEnabled)
+{
+  Instance().m_RedrawScheduler.SetPacing (theIsEnabled ? RedrawScheduler::Pacing::AnimationFrame
+                                                       : RedrawScheduler::Pacing::AsyncCall);
+}
+
+// ================================================================
+// Function : frameIntervalStats
+// Purpose  :
+// ================================================================
+emscripten::val WasmOcctView::frameIntervalStats()
+{
+  double aMeanMs = 0.0, aJitterMs = 0.0;
+  Instance().m_PerfOverlay.GetFrameIntervals (aMeanMs, aJitterMs);
+  emscripten::val aResult = emscripten::val::object();
+  aResult.set ("meanIntervalMs", aMeanMs);
+  aResult.set ("jitterMs",       aJitterMs);
+  aResult.set ("skippedFrames",  double(Instance().m_RedrawScheduler.GetSkippedFrames()));
+  return aResult;
+}
+
+// ================================================================
+// Function : UpdateMousePosition
+// Purpose  :
+// ================================================================
+bool WasmOcctView::UpdateMousePosition (const Graphic3d_Vec2i& thePoint,
+                                        Aspect_VKeyMouse theButtons,
+                                        Aspect_VKeyFlags theModifiers,
+                                        bool theIsEmulated)
+{
+  m_InputRecorder.RecordMouse (InputRecord::Kind::MouseMove, thePoint, theButtons, theModifiers);
+  return AIS_ViewController::UpdateMousePosition (thePoint, theButtons, theModifiers, theIsEmulated);
+}
+
+// ================================================================
+// Function : UpdateMouseButtons
+// Purpose  :
+// ================================================================
+bool WasmOcctView::UpdateMouseButtons (const Graphic3d_Vec2i& thePoint,
+                                       Aspect_VKeyMouse theButtons,
+                                       Aspect_VKeyFlags theModifiers,
+                                       bool theIsEmulated)
+{
+  m_InputRecorder.RecordMouse (InputRecord::Kind::MouseButtons, thePoint, theButtons, theModifiers);
+  return AIS_ViewController::UpdateMouseButtons (thePoint, theButtons, theModifiers, theIsEmulated);
+}
+
+// ================================================================
+// Function : UpdateMouseScroll
+// Purpose  :
+// ================================================================
+bool WasmOcctView::UpdateMouseScroll (const Aspect_ScrollDelta& theDelta)
+{
+  m_InputRecorder.RecordWheel (theDelta);
+  return AIS_ViewController::UpdateMouseScroll (theDelta);
+}
+
+// ================================================================
+// Function : AddTouchPoint
+// Purpose  :
+// ================================================================
+void WasmOcctView::AddTouchPoint (Standard_Size theId,
+                                  const Graphic3d_Vec2d& thePnt,
+                                  Standard_Boolean theClearBefore)
+{
+  m_InputRecorder.RecordTouch (InputRecord::Kind::TouchAdd, theId, thePnt);
+  AIS_ViewController::AddTouchPoint (theId, thePnt, theClearBefore);
+}
+
+// ================================================================
+// Function : UpdateTouchPoint
+// Purpose  :
+// ================================================================
+void WasmOcctView::UpdateTouchPoint (Standard_Size theId,
+                                     const Graphic3d_Vec2d& thePnt)
+{
+  m_InputRecorder.RecordTouch (InputRecord::Kind::TouchUpdate, theId, thePnt);
+  AIS_ViewController::UpdateTouchPoint (theId, thePnt);
+}
+
+// ================================================================
+// Function : RemoveTouchPoint
+// Purpose  :
+// ================================================================
+bool WasmOcctView::RemoveTouchPoint (Standard_Size theId,
+                                     Standard_Boolean theClearSelectPnts)
+{
+  m_InputRecorder.RecordTouch (InputRecord::Kind::TouchRemove, theId, Graphic3d_Vec2d());
+  return AIS_ViewController::RemoveTouchPoint (theId, theClearSelectPnts);
+}
+
+// ================================================================
+// Function : setDynamicResolution
+// Purpose  :
+// ================================================================
+void WasmOcctView::setDynamicResolution (bool theIsEnabled, double theTargetRedrawMs, double theMinScale, double theMotionScale)
+{
+  DynamicResolution::Settings& aSettings = Instance().m_DynamicResolution.ChangeSettings();
+  aSettings.Enabled = theIsEnabled;
+  aSettings.TargetRedrawMs = theTargetRedrawMs;
+  aSettings.MinScale = (float )std::clamp (theMinScale, 0.125, 1.0);
+  aSettings.MotionScale = (float )std::clamp (theMotionScale, double(aSettings.MinScale), 1.0);
+  Instance().UpdateView();
+}
+
+// ================================================================
+// Function : setInteractionLod
+// Purpose  :
+// ================================================================
+void WasmOcctView::setInteractionLod (bool theIsEnabled, double theProxyPixels, bool theToHideBoundaries)
+{
+  InteractionLod::Settings& aSettings = Instance().m_InteractionLod.ChangeSettings();
+  aSettings.Enabled = theIsEnabled;
+  aSettings.ProxyPixels = std::max (theProxyPixels, 0.0);
+  aSettings.HideBoundaries = theToHideBoundaries;
+  Instance().UpdateView();
+}
+
+// ================================================================
+// Function : setSizeCulling
+// Purpose  :
+// ================================================================
+void WasmOcctView::setSizeCulling (bool theIsEnabled, double theMinPixels)
+{
+  SizeCulling& aCulling = Instance().m_SizeCulling;
+  aCulling.SetEnabled (theIsEnabled);
+  aCulling.SetMinPixels (std::max (theMinPixels, 0.0));
+  Instance().UpdateView();
+}
+
+// ================================================================
+// Function : setSizeCullingExempt
+// Purpose  :
+// ================================================================
+bool WasmOcctView::setSizeCullingExempt (const std::string& theName, bool theIsExempt)
+{
+  WasmOcctView& aViewer = Instance();
+  std::vector<Handle(AIS_InteractiveObject)> anObjects;
+  if (!AppManager::GetInstance().CollectGeometryShapes (theName, anObjects))
+  {
+    return false;
+  }
+
+  for (const Handle(AIS_InteractiveObject)& anObject : anObjects)
+  {
+    aViewer.m_SizeCulling.SetExempt (aViewer.myContext, anObject, SizeCulling::Pinned, theIsExempt);
+  }
+  aViewer.UpdateView();
+  return true;
+}
+
+// ================================================================
+// Function : sizeCullingStats
+// Purpose  :
+// ================================================================
+emscripten::val WasmOcctView::sizeCullingStats()
+{
+  const SizeCulling::Stats& aStats = Instance().m_SizeCulling.GetStats();
+  emscripten::val aResult = emscripten::val::object();
+  aResult.set ("exemptCount",      double(aStats.ExemptCount));
+  aResult.set ("culledStructures", double(aStats.CulledStructures));
+  aResult.set ("totalStructures",  double(aStats.TotalStructures));
+  aResult.set ("drawCalls",        double(aStats.ElementsNotCulled));
+  return aResult;
+}
+
+// ================================================================
+// Function : OnSelectionChanged
+// Purpose  :
+// ================================================================
+void WasmOcctView::OnSelectionChanged (const Handle(AIS_InteractiveContext)& theCtx,
+                                       const Handle(V3d_View)& theView)
+{
+  AIS_ViewController::OnSelectionChanged (theCtx, theView);
+
+  std::vector<Handle(AIS_InteractiveObject)> aSelected;
+  for (theCtx->InitSelected(); theCtx->MoreSelected(); theCtx->NextSelected())
+  {
+    aSelected.push_back (theCtx->SelectedInteractive());
+  }
+  m_SizeCulling.ReplaceExempt (theCtx, SizeCulling::Selected, aSelected);
+}
+
+// ================================================================
+// Function : startInputRecording
+// Purpose  :
+// ================================================================
+void WasmOcctView::startInputRecording()
+{
+  WasmOcctView& aViewer = Instance();
+  aViewer.m_InputReplay.Stop();
+  Graphic3d_Vec2i aSize;
+  aViewer.myView->Window()->Size (aSize.x(), aSize.y());
+  aViewer.m_InputRecorder.Start (aSize);
+}
+
+// ================================================================
+// Function : stopInputRecording
+// Purpose  :
+// ================================================================
+bool WasmOcctView::stopInputRecording (const std::string& thePath)
+{
+  InputRecorder& aRecorder = Instance().m_InputRecorder;
+  aRecorder.Stop();
+  if (!aRecorder.Save (thePath))
+  {
+    Message::SendFail() << "Error: unable to write input log '" << thePath.c_str() << "'";
+    return false;
+  }
+  Message::SendInfo() << "Input log '" << thePath.c_str() << "': " << (int )aRecorder.GetRecordCount() << " records";
+  return true;
+}
+
+// ================================================================
+// Function : startInputReplay
+// Purpose  :
+// ================================================================
+bool WasmOcctView::startInputReplay (const std::string& thePath, bool theToMaxSpeed)
+{
+  WasmOcctView& aViewer = Instance();
+  Graphic3d_Vec2i aLogSize, aSize;
+  if (!aViewer.m_InputReplay.Load (thePath, aLogSize))
+  {
+    Message::SendFail() << "Error: unable to read input log '" << thePath.c_str() << "'";
+    return false;
+  }
+
+  aViewer.myView->Window()->Size (aSize.x(), aSize.y());
+  if (aLogSize != aSize)
+  {
+    Message::SendWarning() << "Warning: input log recorded on a " << aLogSize.x() << "x" << aLogSize.y()
+                           << " canvas, replayed on " << aSize.x() << "x" << aSize.y();
+  }
+  aViewer.m_InputRecorder.Stop();
+  aViewer.m_InputReplay.Start (theToMaxSpeed);
+  if (theToMaxSpeed && !aViewer.m_GLContext.IsNull())
+  {
+    // back-to-back frames without waiting for animation frames: one recorded frame of events, then a synchronous
+    // flush and redraw of the 3D view (ImGui excluded), glFinish() so that the GPU work is included
+    while (aViewer.m_InputReplay.IsPlaying())
+    {
+      aViewer.m_InputReplay.BeginFrame (aViewer);
+      aViewer.FlushViewEvents (aViewer.myContext, aViewer.myView, true);
+      aViewer.m_GLContext->core11fwd->glFinish();
+      aViewer.m_InputReplay.EndFrame();
+    }
+    sendInputReplayStats (aViewer.m_InputReplay.GetStats());
+  }
+  aViewer.m_RedrawScheduler.Request();
+  return true;
+}
+
+// ================================================================
+// Function : inputReplayStats
+// Purpose  :
+// ================================================================
+emscripten::val WasmOcctView::inputReplayStats()
+{
+  const InputReplay::Stats& aStats = Instance().m_InputReplay.GetStats();
+  emscripten::val aResult = emscripten::val::object();
+  aResult.set ("playing",     Instance().m_InputReplay.IsPlaying());
+  aResult.set ("frameCount",  double(aStats.FrameCount));
+  aResult.set ("eventCount",  double(aStats.EventCount));
+  aResult.set ("wallMs",      aStats.WallMs);
+  aResult.set ("meanFrameMs", aStats.MeanFrameMs);
+  aResult.set ("p50FrameMs",  aStats.P50FrameMs);
+  aResult.set ("p95FrameMs",  aStats.P95FrameMs);
+  aResult.set ("p99FrameMs",  aStats.P99FrameMs);
+  aResult.set ("maxFrameMs",  aStats.MaxFrameMs);
+  return aResult;
+}
+
+// ================================================================
+// Function : onCanvasLayoutChanged
+// Purpose  :
+// ================================================================
+void WasmOcctView::onCanvasLayoutChanged (double theLeft, double theTop)
+{
+  Instance().m_CanvasOffset.SetValues (theLeft, theTop);
+}
+
 // Module exports
 EMSCRIPTEN_BINDINGS(OccViewerModule) {
   emscripten::function("setCubemapBackground", &WasmOcctView::setCubemapBackground);
@@ -1415,4 +2340,34 @@ EMSCRIPTEN_BINDINGS(OccViewerModule) {
   emscripten::function("selectFaceMode", &WasmOcctView::selectFaceMode);
   emscripten::function("selectSolidMode", &WasmOcctView::selectSolidMode);
   emscripten::function("showScale", &WasmOcctView::showScale);
+  emscripten::function("translateGeometry", &WasmOcctView::translateGeometry);
+  emscripten::function("setGeometryVisible", &WasmOcctView::setGeometryVisible);
+  emscripten::function("queryRegion", &WasmOcctView::queryRegion);
+  emscripten::function("benchmarkSubassemblyMove", &WasmOcctView::benchmarkSubassemblyMove);
+  emscripten::function("instanceMatrices", &WasmOcctView::instanceMatrices);
+  emscripten::function("instanceGeometryIds", &WasmOcctView::instanceGeometryIds);
+  emscripten::function("traceDump", &WasmOcctView::traceDump);
+  emscripten::function("traceClear", &WasmOcctView::traceClear);
+  emscripten::function("memoryReport", &WasmOcctView::memoryReport);
+  emscripten::function("setMemoryBudget", &WasmOcctView::setMemoryBudget);
+  emscripten::function("setMergedStatic", &WasmOcctView::setMergedStatic);
+  emscripten::function("setPlanarWithoutNormals", &WasmOcctView::setPlanarWithoutNormals);
+  emscripten::function("mergedBatchStats", &WasmOcctView::mergedBatchStats);
+  emscripten::function("memoryGovernorStats", &WasmOcctView::memoryGovernorStats);
+  emscripten::function("enablePartStore", &WasmOcctView::enablePartStore);
+  emscripten::function("partStoreStats", &WasmOcctView::partStoreStats);
+  emscripten::function("setTargetFps", &WasmOcctView::setTargetFps);
+  emscripten::function("setIdleMode", &WasmOcctView::setIdleMode);
+  emscripten::function("setAnimationFramePacing", &WasmOcctView::setAnimationFramePacing);
+  emscripten::function("frameIntervalStats", &WasmOcctView::frameIntervalStats);
+  emscripten::function("setDynamicResolution", &WasmOcctView::setDynamicResolution);
+  emscripten::function("setInteractionLod", &WasmOcctView::setInteractionLod);
+  emscripten::function("setSizeCulling", &WasmOcctView::setSizeCulling);
+  emscripten::function("setSizeCullingExempt", &WasmOcctView::setSizeCullingExempt);
+  emscripten::function("sizeCullingStats", &WasmOcctView::sizeCullingStats);
+  emscripten::function("startInputRecording", &WasmOcctView::startInputRecording);
+  emscripten::function("stopInputRecording", &WasmOcctView::stopInputRecording);
+  emscripten::function("startInputReplay", &WasmOcctView::startInputReplay);
+  emscripten::function("inputReplayStats", &WasmOcctView::inputReplayStats);
+  emscripten::function("onCanvasLayoutChanged", &WasmOcctView::onCanvasLayoutChanged);
 }
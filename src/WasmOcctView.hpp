@@ -24,14 +24,27 @@
 
 #include <AIS_InteractiveContext.hxx>
 #include <AIS_ViewController.hxx>
+#include <Bnd_Box.hxx>
 #include <V3d_View.hxx>
 
 #include <emscripten.h>
 #include <emscripten/html5.h>
+#include <emscripten/val.h>
+
+#include "DynamicResolution.hpp"
+#include "InputRecorder.hpp"
+#include "InputReplay.hpp"
+#include "InputRouter.hpp"
+#include "InteractionLod.hpp"
+#include "MemoryPanel.hpp"
+#include "PerfOverlay.hpp"
+#include "RedrawScheduler.hpp"
+#include "SizeCulling.hpp"
 
 
 class AIS_ViewCube;
 class OpenGl_Context;
+class OpenGl_FrameBuffer;
 struct ImGuiContext;
 struct GLFWwindow;
 
@@ -114,6 +127,110 @@ public: //! @name methods exported by Module
 
   static void showScale();
 
+  //! Return world transforms of all placed instances as a Float32Array view (16 floats per instance, column-major).
+  //! The view aliases wasm memory and becomes invalid after the next import or memory growth.
+  static emscripten::val instanceMatrices();
+
+  //! Return geometry IDs of all placed instances as an Int32Array view, parallel to instanceMatrices().
+  static emscripten::val instanceGeometryIds();
+
+  //! Translate named geometry (and its assembly subtree) by the given offset in its parent frame.
+  //! @return FALSE if object was not found
+  static bool translateGeometry (const std::string& theName,
+                                 double theDX, double theDY, double theDZ);
+
+  //! Show or hide named geometry (and its assembly subtree).
+  //! @return FALSE if object was not found
+  static bool setGeometryVisible (const std::string& theName, bool theToShow);
+
+  //! Return IDs of visible geometries whose bounding box intersects the given region.
+  static emscripten::val queryRegion (double theXMin, double theYMin, double theZMin,
+                                      double theXMax, double theYMax, double theZMax);
+
+  //! Benchmark moving the named subassembly of the imported model.
+  //! Each of theNbFrames frames translates it back or forth with GeometryManager::MoveGeometry() and redraws the view
+  //! synchronously (GPU included); returns and prints the average and 95th percentile of both phases.
+  //! Reproducible fixture: import the output of `Occt-Wasm-ImGui-generator deep --depth 2 --count 5000 deep.step`
+  //! and pass "Assembly_1_1", the 5000-part subassembly under the product.
+  static emscripten::val benchmarkSubassemblyMove (const std::string& theName, int theNbFrames);
+
+  //! Return recorded trace events as Chrome trace JSON (load into chrome://tracing or ui.perfetto.dev).
+  static std::string traceDump();
+
+  //! Drop all recorded trace events.
+  static void traceClear();
+
+  //! Return per-geometry memory footprint (with subtree totals) as JSON.
+  static std::string memoryReport();
+
+  //! Set the budget for rendering resources of erased geometry in megabytes (0 or less for unlimited).
+  static void setMemoryBudget (double theMegabytes);
+
+  //! Draw solids as per-color merged batches (few draw calls, whole-part picking only) or one object per solid.
+  static void setMergedStatic (bool theIsEnabled);
+
+  //! Build merged batches of parts made of planar faces without normals.
+  static void setPlanarWithoutNormals (bool theIsEnabled);
+
+  //! Return vertex/buffer sizes of the merged batches and the duration of the redraw uploading them.
+  static emscripten::val mergedBatchStats();
+
+  //! Return memory governor counters as an object (budget, resident and evicted bytes, eviction and rebuild counts).
+  static emscripten::val memoryGovernorStats();
+
+  //! Move B-Rep and triangulation of evicted parts to a backing store under /parts (requires a memory budget).
+  //! The directory is on MEMFS, which keeps the blobs in JS memory outside the wasm heap; they last for the session only.
+  static bool enablePartStore();
+
+  //! Return part store counters as an object (stored parts and bytes, load count and latency in ms).
+  static emscripten::val partStoreStats();
+
+  //! Limit the redraw rate (0 for the display refresh rate).
+  static void setTargetFps (double theFps);
+
+  //! In idle mode frames are only drawn on input or view changes, otherwise continuously.
+  static void setIdleMode (bool theIsIdle);
+
+  //! Schedule frames on requestAnimationFrame (default), or with the former zero-delay emscripten_async_call()
+  //! to compare frame pacing.
+  static void setAnimationFramePacing (bool theIsEnabled);
+
+  //! Return the mean frame interval and its jitter (standard deviation) over the last frames, in ms.
+  static emscripten::val frameIntervalStats();
+
+  //! Lower the render resolution while the camera moves (and further when 3D redraws exceed theTargetRedrawMs),
+  //! full resolution once the view is at rest. Scales are fractions of the backing store resolution.
+  static void setDynamicResolution (bool theIsEnabled, double theTargetRedrawMs, double theMinScale, double theMotionScale);
+
+  //! Draw geometry projected smaller than theProxyPixels as bounding boxes and hide face boundaries
+  //! while the camera moves, full detail once the view is at rest.
+  static void setInteractionLod (bool theIsEnabled, double theProxyPixels, bool theToHideBoundaries);
+
+  //! Skip objects projected smaller than theMinPixels; the selection is always drawn.
+  static void setSizeCulling (bool theIsEnabled, double theMinPixels);
+
+  //! Exempt the named geometry and its subtree from size culling, or restore it.
+  static bool setSizeCullingExempt (const std::string& theName, bool theIsExempt);
+
+  //! Return size culling counters of the last frame as an object (exempt objects, culled and total structures, draw calls).
+  static emscripten::val sizeCullingStats();
+
+  //! Start recording the input reaching the 3D view.
+  static void startInputRecording();
+
+  //! Stop recording and write the input log into a file of the virtual file system.
+  static bool stopInputRecording (const std::string& thePath);
+
+  //! Replay an input log at its recorded pace, or as fast as possible: the whole log is replayed before returning,
+  //! each recorded frame followed by a synchronous flush and 3D redraw.
+  static bool startInputReplay (const std::string& thePath, bool theToMaxSpeed);
+
+  //! Return frame timings of the last input replay as an object.
+  static emscripten::val inputReplayStats();
+
+  //! Canvas position in the page (CSS pixels), pushed by the layout observer installed in initWindow().
+  static void onCanvasLayoutChanged (double theLeft, double theTop);
+
 //! Open STEP object from memory.
   //! @param theName    [in] object name
   //! @param theBuffer  [in] pointer to data
@@ -147,12 +264,6 @@ public:
   //! Request view redrawing.
   void UpdateView();
 
-    // Getters
-    TopAbs_ShapeEnum GetSelectionMode() const { return m_SelectionMode; }
-  
-    // Setters
-    void SetSelectionMode(TopAbs_ShapeEnum mode) { m_SelectionMode = mode; }
-
 private:
 
   //! Create window.
@@ -170,6 +281,12 @@ private:
   //! Flush events and redraw view.
   void redrawView();
 
+  //! (Re)create the framebuffer caching the 3D image when the window size changed.
+  void updateSceneCache();
+
+  //! Copy the cached 3D image to the window, ImGui is drawn over it.
+  void composeSceneCache();
+
   //! Handle view redraw.
   virtual void handleViewRedraw (const Handle(AIS_InteractiveContext)& theCtx,
                                  const Handle(V3d_View)& theView) override;
@@ -186,6 +303,36 @@ private:
   virtual void KeyUp (Aspect_VKey theKey,
                       double theTime) override;
 
+  //! Input reaching the controller is recorded while InputRecorder is active.
+  virtual bool UpdateMousePosition (const Graphic3d_Vec2i& thePoint,
+                                    Aspect_VKeyMouse theButtons,
+                                    Aspect_VKeyFlags theModifiers,
+                                    bool theIsEmulated) override;
+
+  virtual bool UpdateMouseButtons (const Graphic3d_Vec2i& thePoint,
+                                   Aspect_VKeyMouse theButtons,
+                                   Aspect_VKeyFlags theModifiers,
+                                   bool theIsEmulated) override;
+
+  virtual bool UpdateMouseScroll (const Aspect_ScrollDelta& theDelta) override;
+
+  virtual void AddTouchPoint (Standard_Size theId,
+                              const Graphic3d_Vec2d& thePnt,
+                              Standard_Boolean theClearBefore) override;
+
+  virtual void UpdateTouchPoint (Standard_Size theId,
+                                 const Graphic3d_Vec2d& thePnt) override;
+
+  virtual bool RemoveTouchPoint (Standard_Size theId,
+                                 Standard_Boolean theClearSelectPnts) override;
+
+  //! Keep the selection exempt from size culling.
+  virtual void OnSelectionChanged (const Handle(AIS_InteractiveContext)& theCtx,
+                                   const Handle(V3d_View)& theView) override;
+
+  //! Return bounds of all visible geometry (from the geometry BVH) and named objects.
+  Bnd_Box sceneBounds() const;
+
   //! Dump WebGL context information.
   void dumpGlInfo (bool theIsBasic);
 
@@ -215,6 +362,9 @@ private:
   //! Focus change event.
   EM_BOOL onFocusEvent (int theEventType, const EmscriptenFocusEvent* theEvent);
 
+  //! Page visibility change event.
+  EM_BOOL onVisibilityEvent (int theEventType, const EmscriptenVisibilityChangeEvent* theEvent);
+
 //! @name Emscripten callbacks (static functions)
 private:
 
@@ -242,9 +392,10 @@ private:
   static EM_BOOL onFocusCallback (int theEventType, const EmscriptenFocusEvent* theEvent, void* theView)
   { return ((WasmOcctView* )theView)->onFocusEvent (theEventType, theEvent); }
 
-	static void s_onMouseMove(GLFWwindow* window, double thePosX, double thePosY);
+  static EM_BOOL onVisibilityCallback (int theEventType, const EmscriptenVisibilityChangeEvent* theEvent, void* theView)
+  { return ((WasmOcctView* )theView)->onVisibilityEvent (theEventType, theEvent); }
+
 	static void s_onWindowResized(GLFWwindow* window, int width, int height);
-	static void s_onMouseButton(GLFWwindow* window, int button, int action, int mods);
 
   float m_Location[3] { 0.0f, 0.0f, 0.0f };
   void MakeBox(const float* location);
@@ -292,11 +443,25 @@ private:
     float                          myDevicePixelRatio; //!< device pixel ratio for handling high DPI displays
     unsigned int                   myUpdateRequests;   //!< counter for unhandled update requests
 
-    TopAbs_ShapeEnum m_SelectionMode;
     static bool m_bShowScale;
 
     Handle(OpenGl_Context) m_GLContext;
+    Handle(OpenGl_FrameBuffer) m_SceneFbo;  // Target of the 3D view, null when blitting is not supported
+    bool m_bSceneCached { false };          // m_SceneFbo holds the current 3D image
+    Graphic3d_Vec2d m_CanvasOffset;         // Canvas top left in the page, kept up to date by jsObserveCanvasLayout()
+    Graphic3d_WorldViewProjState m_CameraState;  // At the last redraw, to detect camera motion
+    DynamicResolution m_DynamicResolution;
+    InteractionLod m_InteractionLod;
+    SizeCulling m_SizeCulling;
+    bool m_bMeasureBatchUpload { false };  // The next full redraw uploads rebuilt merged batches
+    double m_BatchUploadMs { 0.0 };
     ImGuiContext* m_ImGuiContext;
+    PerfOverlay m_PerfOverlay;
+    MemoryPanel m_MemoryPanel;
+    RedrawScheduler m_RedrawScheduler;
+    InputRouter m_InputRouter;
+    InputRecorder m_InputRecorder;
+    InputReplay m_InputReplay;
 };
 
 #endif // _WasmOcctView_HeaderFile